@@ -18,6 +18,7 @@
 #include <libgb/tile_allocation.hpp>
 #include <libgb/tile_builder.hpp>
 #include <libgb/video.hpp>
+#include <libgb/vram_queue.hpp>
 
 #include "pills.hpp"
 #include "shared.defs"
@@ -52,6 +53,8 @@ static constexpr auto target_window_position_x = board_screen_offset_x;
 static auto window_position_y = target_window_position_y;
 static auto window_position_x = target_window_position_x;
 
+static libgb::VramQueue<16> vram_queue;
+
 struct Coord {
   int8_t x;
   int8_t y;
@@ -145,9 +148,10 @@ auto setup_lcd_controller() -> void {
   });
 }
 
-[[gnu::noinline]] auto setup_scene(libgb::ScopedVRAMGuard const &guard)
+[[gnu::noinline]] auto setup_scene(libgb::is_vram_guard auto const &guard)
     -> void {
-  libgb::setup_scene_tile_mapping<scene_manager, 0>(guard);
+  libgb::setup_scene_tile_mapping<scene_manager, 0,
+                                  libgb::TileDataFormat::compressed>(guard);
   libgb::fill_tile_mapping<libgb::TileMap::map_1>(
       scene_manager.background_tile_index(0, black_tile));
 
@@ -193,9 +197,10 @@ struct CurrentGrid {
   using Colors =
       libgb::Array<libgb::Array<PieceColor, board_stride>, board_height>;
 
-  [[gnu::aligned(512)]] static inline GridData m_data = {};
-  [[gnu::aligned(512)]] static inline Connections m_connections = {};
-  [[gnu::aligned(512)]] static inline Colors m_colors = {};
+  // A page each, so copies and clears of a whole grid stay page-local
+  static inline libgb::PageAligned<GridData> m_data = {};
+  static inline libgb::PageAligned<Connections> m_connections = {};
+  static inline libgb::PageAligned<Colors> m_colors = {};
 
   static constexpr auto is_empty(uint8_t y, uint8_t x) -> bool {
     return m_data[y][x] == scene_manager.background_tile_index(0, black_tile);
@@ -354,9 +359,12 @@ struct CurrentGrid {
 
 constinit static CurrentGrid current_grid = {};
 
-// Defined directly in ASM... The compiler should eventually be good enough to
-// generate this tho.
-extern "C" void copy_grid_into_vram_map_1(CurrentGrid::GridData *grid);
+[[gnu::noinline]] static auto
+copy_grid_into_vram_map_1(CurrentGrid::GridData const *grid) -> void {
+  // Offset by a column for the left border
+  libgb::blit_grid<board_width, board_height, board_stride, 0x9c00 + 1, true>(
+      (libgb::TileIndex const *)grid);
+}
 
 struct FallingPiece {
   static constexpr libgb::Array underlying_piece_sprites = {
@@ -696,7 +704,7 @@ int main() {
   setup_lcd_controller();
   libgb::clear_sprite_map(libgb::inactive_sprite_map);
   libgb::copy_into_active_sprite_map(libgb::inactive_sprite_map);
-  setup_scene(libgb::ScopedVRAMGuard{});
+  setup_scene(libgb::ScopedLCDOffGuard{});
 
   generate_falling_piece();
   generate_falling_piece();
@@ -713,14 +721,16 @@ int main() {
       handle_gameplay_updates();
     }
 
-    libgb::wait_for_interrupt<libgb::Interrupt::vblank>();
+    vram_queue.enqueue_register(libgb::arch::window_position_y_addr,
+                                libgb::to_underlying(window_position_y));
+    vram_queue.enqueue_register(libgb::arch::window_position_x_plus_7_addr,
+                                libgb::to_underlying(window_position_x) + 7);
+
+    libgb::wait_for_interrupt<libgb::Interrupt::vblank,
+                              [] { vram_queue.drain(); }>();
     // libgb::wait_for_interrupt<libgb::Interrupt::vblank>();
     //  copy_grid_into_vram_map_1((CurrentGrid::GridData*)&current_grid.m_colors);
-    copy_grid_into_vram_map_1(&current_grid.m_data);
-
-    libgb::arch::set_window_position_y(libgb::to_underlying(window_position_y));
-    libgb::arch::set_window_position_x_plus_7(
-        libgb::to_underlying(window_position_x) + 7);
+    copy_grid_into_vram_map_1(&current_grid.m_data.value);
 
     libgb::copy_into_active_sprite_map(libgb::inactive_sprite_map);
   }
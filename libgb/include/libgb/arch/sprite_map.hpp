@@ -2,6 +2,7 @@
 
 #include <libgb/arch/sprite.hpp>
 #include <libgb/std/array.hpp>
+#include <libgb/std/memcpy.hpp>
 
 extern "C" void __libgb_do_dma(uint8_t addr_upper);
 
@@ -29,6 +30,7 @@ copy_into_active_sprite_map(arch::SpriteMap const &src) -> void {
 [[gnu::always_inline]] inline auto clear_sprite_map(arch::SpriteMap &dst)
     -> void {
   // Hides all sprites and resets attributes to default
-  memset((uint8_t *)&dst.data, 0, sizeof(dst.data));
+  // SpriteMap is page aligned
+  memset_paged<sizeof(dst.data)>((uint8_t *)&dst.data, 0);
 }
 } // namespace libgb
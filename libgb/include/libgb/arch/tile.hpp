@@ -18,4 +18,13 @@ struct Tile {
   }
 };
 static_assert(8 * sizeof(Tile) == 2 * 8 * 8, "8x8 pixels of 2-bit depth");
+
+// A tile that only uses two colours, stored at one bit per pixel and expanded
+// into a Tile on upload
+struct Tile1bpp {
+  libgb::Array<uint8_t, 8> rows;
+  // Colour ids (0-3) for clear and set bits, packed as off * 4 + on
+  uint8_t colors;
+};
+static_assert(sizeof(Tile1bpp) == 9, "8 rows and a byte of colours");
 } // namespace libgb::arch
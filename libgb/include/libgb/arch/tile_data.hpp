@@ -40,7 +40,52 @@ constexpr auto tile_address(TileIndex index, TileAddressingMode mode)
 }
 
 inline auto set_tile_data(TileAddress dst, arch::Tile const &src) -> void {
-  libgb::memcpy((uint8_t volatile *)dst, (const uint8_t *)&src,
-                sizeof(arch::Tile));
+  libgb::memcpy_n<sizeof(arch::Tile)>((uint8_t volatile *)dst,
+                                      (const uint8_t *)&src);
+}
+
+// M-cycles to set aside per set_tile_data when uploads have to fit in vblank.
+// Conservative, it covers the loop driving the uploads too.
+static constexpr uint16_t tile_upload_cost = 176;
+
+namespace impl {
+// Each bit plane is either constant, the row mask or its inverse. With both
+// colours known up front this is a load and two stores per row.
+template <uint8_t off_color, uint8_t on_color>
+[[gnu::noinline]] auto expand_1bpp_tile(uint8_t volatile *dst,
+                                        uint8_t const *rows) -> void {
+  constexpr uint8_t off_low = (off_color & 1U) != 0 ? 0xff : 0x00;
+  constexpr uint8_t on_low = (on_color & 1U) != 0 ? 0xff : 0x00;
+  constexpr uint8_t off_high = (off_color & 2U) != 0 ? 0xff : 0x00;
+  constexpr uint8_t on_high = (on_color & 2U) != 0 ? 0xff : 0x00;
+
+#pragma clang loop unroll(full)
+  for (uint8_t row = 0; row < 8; row += 1) {
+    uint8_t const mask = rows[row];
+    dst[2 * row] = off_low ^ (mask & (off_low ^ on_low));
+    dst[2 * row + 1] = off_high ^ (mask & (off_high ^ on_high));
+  }
+}
+
+using Expand1bppKernel = auto (*)(uint8_t volatile *, uint8_t const *) -> void;
+
+// Indexed by Tile1bpp::colors, off_color * 4 + on_color
+static constexpr Expand1bppKernel expand_1bpp_kernels[] = {
+    expand_1bpp_tile<0, 0>, expand_1bpp_tile<0, 1>, expand_1bpp_tile<0, 2>,
+    expand_1bpp_tile<0, 3>, expand_1bpp_tile<1, 0>, expand_1bpp_tile<1, 1>,
+    expand_1bpp_tile<1, 2>, expand_1bpp_tile<1, 3>, expand_1bpp_tile<2, 0>,
+    expand_1bpp_tile<2, 1>, expand_1bpp_tile<2, 2>, expand_1bpp_tile<2, 3>,
+    expand_1bpp_tile<3, 0>, expand_1bpp_tile<3, 1>, expand_1bpp_tile<3, 2>,
+    expand_1bpp_tile<3, 3>,
+};
+} // namespace impl
+
+// Meant to be inlined with a compile-time tile, so that the right kernel is
+// picked statically
+[[gnu::always_inline]] inline auto set_tile_data(TileAddress dst,
+                                                 arch::Tile1bpp const &src)
+    -> void {
+  impl::expand_1bpp_kernels[src.colors](
+      (uint8_t volatile *)dst, src.rows.data());
 }
 } // namespace libgb
@@ -67,4 +67,28 @@ template <TileMap map, size_t width, size_t height>
     }
   }
 }
+
+// Copies a width x height grid, whose rows are src_stride apart, into the tile
+// map at dst_address. Fully unrolled into a store per cell at an absolute
+// address. With flip_y, row 0 of src ends up at the bottom.
+template <size_t width, size_t height, size_t src_stride, uint16_t dst_address,
+          bool flip_y>
+[[gnu::always_inline]] inline auto blit_grid(TileIndex const *src) -> void {
+  static_assert(src_stride >= width);
+  static_assert(width <= +tile_map_width);
+
+#pragma clang loop unroll(full)
+  for (size_t row = 0; row < height; row += 1) {
+    constexpr auto dst_stride = sizeof(arch::TileMapData::Row);
+    auto const dst_row = flip_y ? height - row - 1 : row;
+    auto *dst = (TileIndex volatile *)(dst_address + dst_row * dst_stride);
+
+    // Walk src with a single pointer, this maps onto `ld a, (hl+)`
+#pragma clang loop unroll(full)
+    for (size_t column = 0; column < width; column += 1) {
+      dst[column] = *src++;
+    }
+    src += src_stride - width;
+  }
+}
 } // namespace libgb
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <libgb/arch/sprite_map.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/memcpy.hpp>
+
+#include <stdint.h>
+
+namespace libgb {
+// Two shadow OAM buffers. Gameplay code builds the next frame's sprites in the
+// back buffer whenever it likes, swap() hands it over and vblank DMAs whichever
+// buffer was handed over last, so a late tick can never show up half-written:
+//
+//   sprites.back()[0] = ...;
+//   sprites.swap();
+//
+//   // From the vblank interrupt, or right after it
+//   libgb::wait_for_interrupt<libgb::Interrupt::vblank,
+//                             [] { sprites.copy_into_active_sprite_map(); }>();
+//
+// After a swap the back buffer holds the frame before last, sync_back() brings
+// it up to date for games that only change a few sprites each frame.
+class DoubleBufferedSpriteMap {
+  // SpriteMap is page aligned, so is each buffer
+  libgb::Array<arch::SpriteMap, 2> m_buffers = {};
+  uint8_t m_back_index = 0;
+  // Only the high byte is needed for the DMA, a single byte is written
+  // atomically so swap() doesn't need to hold off interrupts
+  uint8_t volatile m_front_page = 0;
+
+public:
+  // Call before the first copy_into_active_sprite_map()
+  auto start() -> void {
+    m_back_index = 0;
+    m_front_page = (uint8_t)((uintptr_t)&front() >> 8U);
+  }
+
+  [[nodiscard]] auto front() const -> arch::SpriteMap const & {
+    return m_buffers[m_back_index ^ 1U];
+  }
+
+  [[nodiscard]] auto back() -> arch::SpriteMap & {
+    return m_buffers[m_back_index];
+  }
+
+  auto swap() -> void {
+    m_front_page = (uint8_t)((uintptr_t)&back() >> 8U);
+    m_back_index ^= 1U;
+  }
+
+  auto sync_back() -> void {
+    // Both buffers are page aligned
+    memcpy_paged<sizeof(arch::SpriteMap::data)>(
+        (uint8_t *)&back().data, (uint8_t const *)&front().data);
+  }
+
+  // Must be called during vblank
+  auto copy_into_active_sprite_map() -> void {
+    __libgb_do_dma(m_front_page);
+  }
+};
+} // namespace libgb
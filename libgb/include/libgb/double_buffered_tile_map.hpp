@@ -0,0 +1,81 @@
+#pragma once
+
+#include <libgb/arch/registers.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/dimensions.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/memcpy.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+namespace libgb {
+// Page flipping between the two hardware tile maps for the background. Drawing
+// always goes to the map that isn't on screen, so a redraw can be spread over
+// as many frames as it needs and the screen only ever shows finished frames:
+//
+//   {
+//     libgb::ScopedVRAMGuard guard;
+//     background.set(guard, y, x, tile);
+//     ...
+//   }
+//   background.present();
+//
+// VRAM is still off limits while the PPU draws, whichever map it reads from,
+// so writes take a guard like everything else that touches VRAM.
+// The window must not use either map while this is in use.
+class DoubleBufferedTileMap {
+  TileMap m_front = TileMap::map_0;
+
+  [[nodiscard]] static auto map_data(TileMap map)
+      -> arch::TileMapData volatile & {
+    return arch::tile_maps->maps[+map];
+  }
+
+public:
+  // Call while the LCD is off or during vblank, shows the current front map
+  auto start() -> void {
+    arch::set_lcd_control_bg_tile_map(
+        (arch::TileMapAddressingMode)+m_front);
+  }
+
+  [[nodiscard]] auto front() const -> TileMap { return m_front; }
+
+  [[nodiscard]] auto back() const -> TileMap {
+    return m_front == TileMap::map_0 ? TileMap::map_1 : TileMap::map_0;
+  }
+
+  template <is_vram_guard Guard>
+  auto set(Guard const &, Tiles y, Tiles x, TileIndex tile) -> void {
+    map_data(back()).data[+y][+x] = tile;
+  }
+
+  template <is_vram_guard Guard>
+  auto fill(Guard const &, TileIndex tile) -> void {
+    memset((uint8_t volatile *)&map_data(back()), +tile,
+           sizeof(arch::TileMapData));
+  }
+
+  // After a flip the back map holds the frame before last, this brings it up
+  // to date for incremental redraws
+  template <is_vram_guard Guard> auto sync_back(Guard const &) -> void {
+    memcpy((uint8_t volatile *)&map_data(back()),
+           (uint8_t const *)&map_data(m_front), sizeof(arch::TileMapData));
+  }
+
+  // Shows the back map. Must be called during vblank, e.g. from the vblank
+  // interrupt, switching mid-frame would tear.
+  auto flip() -> void {
+    m_front = back();
+    arch::set_lcd_control_bg_tile_map(
+        (arch::TileMapAddressingMode)+m_front);
+  }
+
+  // Waits for the next vblank and flips, not to be used while a
+  // ScopedVRAMGuard is alive
+  auto present() -> void {
+    wait_for_interrupt<Interrupt::vblank>();
+    flip();
+  }
+};
+} // namespace libgb
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <libgb/arch/registers.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/assert.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libgb {
+namespace impl {
+extern "C" {
+// Defined in hblank_stream.S
+// src and dst are operands of instructions in HRAM, with arbitrary alignment.
+extern uint8_t const *volatile __libgb_hblank_stream_src [[gnu::aligned(1)]];
+extern uint8_t volatile *volatile __libgb_hblank_stream_dst
+    [[gnu::aligned(1)]];
+extern volatile uint16_t __libgb_hblank_stream_chunks [[gnu::aligned(1)]];
+extern volatile uint8_t __libgb_hblank_stream_rewind;
+extern volatile bool __libgb_hblank_stream_done;
+
+__attribute__((gb_interrupt_cc)) void __libgb_hblank_stream_interrupt();
+}
+} // namespace impl
+
+// Must match CHUNK_SIZE in hblank_stream.S
+static constexpr size_t hblank_stream_chunk_size = 4;
+
+// Copies count bytes into VRAM in the background, one chunk per hblank, while
+// the screen stays on and the main loop keeps running. count has to be at least
+// hblank_stream_chunk_size, src must stay alive until the stream is done.
+// This owns the LCD STAT interrupt until it's done, so it can't be combined
+// with ScopedVRAMGuard. A chunk fits with up to ~5 sprites on the line, more
+// shorten hblank too much and writes get dropped.
+inline auto start_hblank_stream(uint8_t volatile *dst, uint8_t const *src,
+                                size_t count) -> void {
+  assert(count >= hblank_stream_chunk_size);
+
+  disable_lcd_status_interrupt();
+
+  // The last chunk would run past count, the first two overlap instead
+  uint8_t const remainder = count % hblank_stream_chunk_size;
+  impl::__libgb_hblank_stream_rewind =
+      remainder == 0 ? 0 : hblank_stream_chunk_size - remainder;
+
+  // Counted with `dec lsb; jr nz; dec msb; jr nz`
+  uint16_t const chunks =
+      (count + hblank_stream_chunk_size - 1) / hblank_stream_chunk_size - 1;
+  uint8_t const lsb = (chunks & 0xffU) + 1U;
+  uint8_t const msb = (chunks >> 8U) + 1U;
+  impl::__libgb_hblank_stream_chunks = (uint16_t)(msb << 8U) | lsb;
+  impl::__libgb_hblank_stream_src = src;
+  impl::__libgb_hblank_stream_dst = dst;
+  impl::__libgb_hblank_stream_done = false;
+
+  set_lcd_interrupt_condition(LCDInterruptCondition::h_blank);
+  // Discard any stale interrupt, it could fire outside of hblank
+  arch::set_interrupt_flag_lcd(false);
+  enable_lcd_status_interrupt(impl::__libgb_hblank_stream_interrupt);
+}
+
+[[nodiscard]] inline auto is_hblank_stream_done() -> bool {
+  return impl::__libgb_hblank_stream_done;
+}
+
+inline auto wait_for_hblank_stream() -> void {
+  while (not is_hblank_stream_done()) {
+    halt();
+  }
+}
+} // namespace libgb
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libgb/arch/registers.hpp>
+#include <libgb/std/traits.hpp>
 
 #include <stdint.h>
 
@@ -163,12 +164,18 @@ template <Interrupt interrupt> struct InterruptScope {
   ~InterruptScope() { disable_interrupt<interrupt>(); }
 };
 
-template <Interrupt interrupt> inline auto wait_for_interrupt() -> void {
+// on_interrupt, if given, runs inside the interrupt handler before we wake up
+template <Interrupt interrupt, auto on_interrupt = nullptr>
+inline auto wait_for_interrupt() -> void {
   static volatile bool has_seen_interrupt;
   has_seen_interrupt = false;
 
-  InterruptScope<interrupt> handler(
-      [] [[gnu::gb_interrupt_cc]] () { has_seen_interrupt = true; });
+  InterruptScope<interrupt> handler([] [[gnu::gb_interrupt_cc]] () {
+    if constexpr (not is_same<remove_cv<decltype(on_interrupt)>, nullptr_t>) {
+      on_interrupt();
+    }
+    has_seen_interrupt = true;
+  });
   while (not has_seen_interrupt) {
     halt();
   }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <libgb/arch/registers.hpp>
+#include <libgb/dimensions.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/assert.hpp>
+#include <libgb/std/memcpy.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libgb {
+namespace impl {
+extern "C" {
+// Defined in int_handlers.S
+// __libgb_raster_next is an operand of an instruction in HRAM, with arbitrary
+// alignment.
+extern uint8_t const *volatile __libgb_raster_next [[gnu::aligned(1)]];
+extern uint8_t const *volatile __libgb_raster_front [[gnu::aligned(1)]];
+extern uint8_t const *volatile __libgb_raster_pending [[gnu::aligned(1)]];
+
+__attribute__((gb_interrupt_cc)) void __libgb_raster_interrupt();
+}
+} // namespace impl
+
+// Per-scanline writes to IO registers (scroll, window, palettes...), e.g. for
+// wobble, parallax bands or a split-screen HUD:
+//
+//   raster.clear();
+//   raster.add(libgb::Pixels{16}, libgb::arch::background_viewport_x_addr, 4);
+//   raster.add(libgb::Pixels{96}, libgb::arch::background_viewport_x_addr, 0);
+//   raster.present();
+//
+// A write applies from its line until the end of the frame or a later write to
+// the same register. Tables are double-buffered, the next frame's table is
+// built in the back buffer while the front one plays, present() hands it over
+// to the handler which switches at the end of the visible frame.
+// This owns the LCD STAT interrupt while started, so it can't be combined with
+// ScopedVRAMGuard or start_hblank_stream().
+template <size_t capacity> class RasterTable {
+  // Must match the layout walked in int_handlers.S
+  struct Entry {
+    // The handler triggers a line early and writes in that line's hblank
+    uint8_t trigger_line;
+    uint8_t register_low;
+    uint8_t value;
+  };
+
+  struct Buffer {
+    // One extra for the entry that ends the frame, and one whose line marks
+    // the end of the table
+    libgb::Array<Entry, capacity + 2> entries;
+  };
+
+  static constexpr uint8_t visible_lines = count_px(screen_dims.get_height());
+  static constexpr uint8_t end_marker = 0xff;
+
+  libgb::Array<Buffer, 2> m_buffers = {};
+  uint8_t m_back_index = 0;
+  uint8_t m_size = 0;
+
+  [[nodiscard]] auto back() -> Buffer & { return m_buffers[m_back_index]; }
+
+  // Rewriting LYC is harmless, the handler overwrites it right after. The
+  // marker goes right after the terminating entry, whatever follows it is left
+  // over from an older, longer table.
+  auto terminate() -> void {
+    back().entries[m_size] = Entry{
+        .trigger_line = visible_lines - 1,
+        .register_low = (uint8_t)arch::lcd_y_compare_addr,
+        .value = visible_lines - 1,
+    };
+    back().entries[m_size + 1].trigger_line = end_marker;
+  }
+
+public:
+  // Starts playing an empty table, the first present()ed one shows up on the
+  // next frame.
+  auto start() -> void {
+    disable_lcd_status_interrupt();
+
+    m_size = 0;
+    terminate();
+    Buffer const &front = back();
+    m_back_index ^= 1U;
+
+    impl::__libgb_raster_front = &front.entries[0].trigger_line;
+    impl::__libgb_raster_next = &front.entries[0].register_low;
+    impl::__libgb_raster_pending = nullptr;
+    arch::set_lcd_y_compare(front.entries[0].trigger_line);
+
+    set_lcd_interrupt_condition(LCDInterruptCondition::compare);
+    // Discard any stale interrupt, it could fire on the wrong line
+    arch::set_interrupt_flag_lcd(false);
+    enable_lcd_status_interrupt(impl::__libgb_raster_interrupt);
+  }
+
+  auto stop() -> void { disable_lcd_status_interrupt(); }
+
+  // Starts building a new table in the back buffer. Waits until the handler
+  // has picked up the previous present()ed table, the back buffer might still
+  // be on screen until then.
+  auto clear() -> void {
+    while (impl::__libgb_raster_pending != nullptr) {
+      halt();
+    }
+    m_size = 0;
+  }
+
+  // Entries must be added in line order, line 0 can't be targeted, set it up
+  // from vblank instead. address must be an IO register (0xff00-0xffff).
+  auto add(Pixels line, intptr_t address, uint8_t value) -> void {
+    assert(m_size < capacity);
+    assert(+line > 0 and +line < visible_lines);
+    assert((address & 0xff00) == 0xff00);
+    assert(m_size == 0 or
+           back().entries[m_size - 1].trigger_line <= +line - 1);
+
+    back().entries[m_size] = Entry{
+        .trigger_line = (uint8_t)(+line - 1),
+        .register_low = (uint8_t)address,
+        .value = value,
+    };
+    m_size += 1;
+  }
+
+  // The handler must never see half of the pending pointer, so interrupts are
+  // held off around the store. When state says they're already off, e.g. from
+  // a vblank handler, this leaves them alone.
+  template <InterruptState state = InterruptState::enabled>
+  auto present() -> void {
+    terminate();
+    if constexpr (state == InterruptState::enabled) {
+      disable_interrupts();
+    }
+    impl::__libgb_raster_pending = &back().entries[0].trigger_line;
+    if constexpr (state == InterruptState::enabled) {
+      enable_interrupts();
+    }
+    m_back_index ^= 1U;
+  }
+};
+} // namespace libgb
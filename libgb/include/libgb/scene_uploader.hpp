@@ -0,0 +1,107 @@
+#pragma once
+
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/fixed_vector.hpp>
+#include <libgb/tile_allocation.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libgb {
+namespace impl {
+struct TileUpload {
+  uint16_t address;
+  // Into all_tile_data<registry>
+  uint16_t tile;
+};
+
+template <Scene scene, TileRegistry registry>
+consteval auto make_scene_tile_uploads() {
+  static constexpr size_t slot_count = Scene::tiles_per_region;
+  static constexpr auto background_offset = registry.m_all_sprite_tiles.size();
+
+  libgb::FixedVector<TileUpload, 3 * slot_count> result = {};
+  auto const add_region =
+      [&](libgb::Array<TileRegistryIndex, slot_count> const &mapping,
+          TileAddressingMode mode, uint8_t first_tile_index, size_t offset) {
+        for (auto const &[index, tile] : enumerate(mapping)) {
+          if (not is_scene_tile(tile)) {
+            continue;
+          }
+          auto const address = tile_address(
+              TileIndex{(uint8_t)(first_tile_index + index)}, mode);
+          result.push_back(TileUpload{+address, (uint16_t)(+tile + offset)});
+        }
+      };
+
+  add_region(scene.m_sprite_tiles, TileAddressingMode::object, 0, 0);
+  add_region(scene.m_background_tiles, TileAddressingMode::bg_window_signed, 0,
+             background_offset);
+  add_region(scene.m_shared_tiles, TileAddressingMode::object,
+             Scene::first_shared_tile_index, background_offset);
+  return result;
+}
+
+template <Scene scene, TileRegistry registry>
+static constexpr auto scene_tile_uploads =
+    to_array<make_scene_tile_uploads<scene, registry>()>();
+} // namespace impl
+
+// Uploads a scene's tiles over several frames instead of stalling in
+// setup_scene_tile_mapping, so the game can keep animating meanwhile:
+//
+//   uploader.start_transition<scene_manager, 0, 1>();
+//   ...
+//   void on_vblank() {
+//     uploader.step(libgb::SceneUploader::default_budget);
+//     ...
+//   }
+//
+// Tiles are uploaded in place, a tile shown on screen changes as soon as its
+// slot is written. Only raw tile data is supported. Caches in reserved slots
+// need invalidating once done, see setup_scene_tile_mapping.
+class SceneUploader {
+  impl::TileUpload const *m_next = nullptr;
+  impl::TileUpload const *m_end = nullptr;
+  arch::Tile const *m_all_tile_data = nullptr;
+
+  template <Scene scene, TileRegistry registry> auto start_uploads() -> void {
+    static constexpr auto &uploads = impl::scene_tile_uploads<scene, registry>;
+    m_next = uploads.begin();
+    m_end = uploads.end();
+    m_all_tile_data = impl::all_tile_data<registry>.data();
+  }
+
+public:
+  // vblank lasts ~1140 M-cycles, leave some headroom for the caller
+  static constexpr uint16_t default_budget = 1100;
+
+  template <SceneManager all_scenes, size_t scene_index> auto start() -> void {
+    start_uploads<all_scenes.m_scenes[scene_index],
+                  all_scenes.m_tile_registry>();
+  }
+
+  // Only uploads the tiles that differ, like transition_scene
+  template <SceneManager all_scenes, size_t from_index, size_t to_index>
+  auto start_transition() -> void {
+    static constexpr auto changes = impl::changed_scene_slots(
+        all_scenes.m_scenes[from_index], all_scenes.m_scenes[to_index]);
+    start_uploads<changes, all_scenes.m_tile_registry>();
+  }
+
+  [[nodiscard]] auto is_done() const -> bool { return m_next == m_end; }
+
+  // Uploads as many tiles as fit in budget M-cycles. VRAM must be accessible
+  // for all of it, e.g. call this right after vblank starts.
+  auto step(uint16_t budget) -> void {
+    while (m_next != m_end and budget >= tile_upload_cost) {
+      budget -= tile_upload_cost;
+      set_tile_data(TileAddress{m_next->address},
+                    m_all_tile_data[m_next->tile]);
+      m_next += 1;
+    }
+  }
+};
+} // namespace libgb
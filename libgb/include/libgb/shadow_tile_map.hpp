@@ -0,0 +1,96 @@
+#pragma once
+
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/dimensions.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/memcpy.hpp>
+
+#include <stdint.h>
+
+namespace libgb {
+enum class RowOrder : uint8_t {
+  top_to_bottom,
+  // Row 0 is the bottom row on screen, e.g. a game board
+  bottom_to_top,
+};
+
+// A WRAM copy of a width x height region of a tile map. Writes only touch the
+// copy and mark their row as dirty, flush() then uploads the dirty rows and
+// nothing else. Rows that don't fit in a frame's budget go out with the next
+// flush.
+template <Tiles width, Tiles height> class ShadowTileMap {
+public:
+  using Row = libgb::Array<TileIndex, +width>;
+
+private:
+  libgb::Array<Row, +height> m_rows = {};
+  // Everything starts out dirty so that the first flush mirrors the whole map
+  libgb::Array<bool, +height> m_is_row_clean = {};
+
+public:
+  // Read only, writes have to go through set() & co to be tracked
+  [[nodiscard]] constexpr auto operator[](uint8_t y) const -> Row const & {
+    return m_rows[y];
+  }
+
+  [[nodiscard]] constexpr auto get(Tiles y, Tiles x) const -> TileIndex {
+    return m_rows[+y][+x];
+  }
+
+  constexpr auto set(Tiles y, Tiles x, TileIndex tile) -> void {
+    m_rows[+y][+x] = tile;
+    m_is_row_clean[+y] = false;
+  }
+
+  auto fill_row(Tiles y, TileIndex tile) -> void {
+    memset_n<sizeof(Row)>((uint8_t *)&m_rows[+y], +tile);
+    m_is_row_clean[+y] = false;
+  }
+
+  // The ranges may overlap
+  auto move_rows(Tiles dst, Tiles src, uint8_t count) -> void {
+    memmove((uint8_t *)&m_rows[+dst], (uint8_t const *)&m_rows[+src],
+            sizeof(Row) * count);
+    for (uint8_t y = +dst; y < +dst + count; y += 1) {
+      m_is_row_clean[y] = false;
+    }
+  }
+
+  auto mark_all_dirty() -> void {
+    memset_n<sizeof(m_is_row_clean)>((uint8_t *)&m_is_row_clean, false);
+  }
+
+  // Conservative estimate, includes the loop in flush()
+  static constexpr uint16_t row_upload_cost = 25 + 6 * +width;
+  // vblank lasts ~1140 M-cycles, leave some headroom for the caller
+  static constexpr uint16_t default_budget = 1100;
+
+  // Uploads as many dirty rows as fit in budget M-cycles with (y, x) as the
+  // top left corner in the tile map, the rest stay dirty for the next flush.
+  // VRAM must be accessible for all of it, e.g. call this from vblank.
+  template <TileMap map, RowOrder order = RowOrder::top_to_bottom>
+  [[gnu::always_inline]] auto flush(Tiles y, Tiles x,
+                                    uint16_t budget = default_budget)
+      -> void {
+#pragma clang loop unroll(full)
+    for (uint8_t row = 0; row < +height; row += 1) {
+      if (m_is_row_clean[row]) {
+        continue;
+      }
+      if (budget < row_upload_cost) {
+        return;
+      }
+      budget -= row_upload_cost;
+      m_is_row_clean[row] = true;
+
+      uint8_t const map_row =
+          order == RowOrder::top_to_bottom ? row : +height - row - 1;
+      memcpy_n<sizeof(Row)>(
+          (uint8_t volatile *)&arch::tile_maps->maps[+map]
+              .data[+y + map_row][+x],
+          (uint8_t const *)&m_rows[row]);
+    }
+  }
+};
+} // namespace libgb
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <libgb/arch/sprite.hpp>
+#include <libgb/arch/sprite_map.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/math.hpp>
+#include <libgb/tile_allocation.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libgb {
+// One hardware sprite of a metasprite, relative to the metasprite's position
+struct MetaspritePart {
+  int8_t offset_y;
+  int8_t offset_x;
+  TileIndex index;
+  arch::SpriteAttributes attributes;
+};
+
+template <size_t PartCount> struct Metasprite {
+  libgb::Array<MetaspritePart, PartCount> parts;
+
+  static constexpr auto size() -> size_t { return PartCount; }
+};
+
+// Folds the flips needed by a deduplicated tile (see SceneManager::sprite_tile)
+// into the part's attributes
+consteval auto metasprite_part(int8_t offset_y, int8_t offset_x,
+                               SpriteTile tile,
+                               arch::SpriteAttributes attributes = {})
+    -> MetaspritePart {
+  attributes.flip_x = attributes.flip_x != tile.flip_x;
+  attributes.flip_y = attributes.flip_y != tile.flip_y;
+  return MetaspritePart{offset_y, offset_x, tile.index, attributes};
+}
+
+// Hands out the slots of a sprite map (inactive_sprite_map unless told
+// otherwise) from first_slot onwards, afresh every frame:
+//
+//   sprites.begin_frame();
+//   sprites.draw<player>(y, x);
+//   for (auto const &enemy : enemies) {
+//     sprites.draw<enemy_sprite>(enemy.y, enemy.x);
+//   }
+//   sprites.end_frame();
+//
+// Sprites are packed from first_slot, so only the slots used this frame are
+// written, plus the ones that were used last frame but aren't any more, which
+// are hidden. Slots before first_slot are left to the game, e.g. for sprites
+// that never move. Positions are in OAM coordinates, (16, 8) is the top left
+// corner of the screen.
+// With a DoubleBufferedSpriteMap, pass back() to begin_frame(). The back
+// buffer last held the frame before last, so slots used by either of the last
+// two frames are hidden.
+class SpriteAllocator {
+  static constexpr uint8_t slot_count =
+      decltype(arch::SpriteMap::data)::size();
+
+  arch::SpriteMap *m_map = &inactive_sprite_map;
+  uint8_t m_first_slot;
+  uint8_t m_next_slot;
+  uint8_t m_previous_end_slot;
+  uint8_t m_before_previous_end_slot;
+
+public:
+  explicit constexpr SpriteAllocator(uint8_t first_slot = 0)
+      : m_first_slot{first_slot}, m_next_slot{first_slot},
+        m_previous_end_slot{first_slot},
+        m_before_previous_end_slot{first_slot} {}
+
+  auto begin_frame(arch::SpriteMap &map = inactive_sprite_map) -> void {
+    m_map = &map;
+    m_next_slot = m_first_slot;
+  }
+
+  // Either all or none of the metasprite is drawn, returns false when it
+  // doesn't fit in the remaining slots
+  template <auto const &metasprite>
+  [[gnu::always_inline]] auto draw(uint8_t y, uint8_t x) -> bool {
+    if (m_next_slot + metasprite.size() > slot_count) {
+      return false;
+    }
+
+    arch::Sprite *sprite = &(*m_map)[m_next_slot];
+#pragma clang loop unroll(full)
+    for (auto const &part : metasprite.parts) {
+      *sprite = arch::Sprite{
+          .pos_y = (uint8_t)(y + part.offset_y),
+          .pos_x = (uint8_t)(x + part.offset_x),
+          .index = part.index,
+          .attributes = part.attributes,
+      };
+      sprite += 1;
+    }
+    m_next_slot += metasprite.size();
+    return true;
+  }
+
+  auto draw(arch::Sprite const &sprite) -> bool {
+    if (m_next_slot == slot_count) {
+      return false;
+    }
+    (*m_map)[m_next_slot] = sprite;
+    m_next_slot += 1;
+    return true;
+  }
+
+  // Hides the slots that were drawn in the last two frames but not this one
+  auto end_frame() -> void {
+    uint8_t const end = max(m_previous_end_slot, m_before_previous_end_slot);
+    for (uint8_t slot = m_next_slot; slot < end; slot += 1) {
+      (*m_map)[slot].pos_y = 0;
+    }
+    m_before_previous_end_slot = m_previous_end_slot;
+    m_previous_end_slot = m_next_slot;
+  }
+
+  [[nodiscard]] auto used_slots() const -> uint8_t {
+    return m_next_slot - m_first_slot;
+  }
+};
+} // namespace libgb
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <libgb/arch/sprite.hpp>
+#include <libgb/arch/sprite_map.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/assert.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libgb {
+// The hardware only draws the first 10 sprites (in OAM order) on each line,
+// the rest silently disappear. This reorders sprites every frame so that
+// crowded lines flicker instead:
+//
+//   stars[index].pos_y = ...;
+//   ...
+//   stars.schedule();
+//   // From vblank
+//   libgb::copy_into_active_sprite_map(libgb::inactive_sprite_map);
+//
+// Sprites are bucketed into 8 line bands by y. Each frame the sprites of a band
+// are written to OAM starting one further along, so every sprite in a crowded
+// band gets its turn at the front. A sprite covers 8 lines, so a crowded line
+// usually crosses two bands, bands are written top to bottom one frame and
+// bottom to top the next so that neither always wins. Sprites overlapping each
+// other at the same x swap which one is on top too.
+// This owns the slots [first_slot, first_slot + capacity) of the map it
+// schedules into, inactive_sprite_map unless told otherwise. Every slot is
+// rewritten each frame, so it works as is with DoubleBufferedSpriteMap::back().
+template <uint8_t capacity> class SpriteScheduler {
+  static_assert(capacity != 0 and capacity <= 40,
+                "SpriteScheduler capacity must fit in OAM");
+
+  static constexpr uint8_t band_shift = 3;
+
+  libgb::Array<arch::Sprite, capacity> m_sprites = {};
+  // Indices into m_sprites, sorted by band. Kept between frames, so sorting
+  // is cheap while sprites stay in their band.
+  libgb::Array<uint8_t, capacity> m_order = [] {
+    libgb::Array<uint8_t, capacity> order = {};
+    for (uint8_t index = 0; index < capacity; index += 1) {
+      order[index] = index;
+    }
+    return order;
+  }();
+  uint8_t m_first_slot;
+  bool m_is_bottom_to_top = false;
+
+public:
+  explicit constexpr SpriteScheduler(uint8_t first_slot = 0)
+      : m_first_slot{first_slot} {
+    assert(first_slot + capacity <= 40);
+  }
+
+  [[nodiscard]] auto operator[](uint8_t index) -> arch::Sprite & {
+    return m_sprites[index];
+  }
+
+  // Writes the sprites to map, once per frame
+  auto schedule(arch::SpriteMap &map = inactive_sprite_map) -> void {
+    libgb::Array<uint8_t, capacity> bands;
+    for (uint8_t index = 0; index < capacity; index += 1) {
+      bands[index] = m_sprites[index].pos_y >> band_shift;
+    }
+
+    // Insertion sort, stable so the rotation within each band is kept
+    for (uint8_t position = 1; position < capacity; position += 1) {
+      uint8_t const index = m_order[position];
+      uint8_t const band = bands[index];
+      uint8_t other = position;
+      while (other > 0 and bands[m_order[other - 1]] > band) {
+        m_order[other] = m_order[other - 1];
+        other -= 1;
+      }
+      m_order[other] = index;
+    }
+
+    arch::Sprite *slot = &map[m_first_slot];
+    // Emits m_order[begin, end) while rotating it by one, the first sprite
+    // goes last
+    auto const emit_band = [&](uint8_t begin, uint8_t end) {
+      uint8_t const first = m_order[begin];
+      *slot = m_sprites[first];
+      slot += 1;
+      for (uint8_t position = begin + 1; position < end; position += 1) {
+        *slot = m_sprites[m_order[position]];
+        slot += 1;
+        m_order[position - 1] = m_order[position];
+      }
+      m_order[end - 1] = first;
+    };
+
+    if (m_is_bottom_to_top) {
+      uint8_t end = capacity;
+      while (end > 0) {
+        uint8_t const band = bands[m_order[end - 1]];
+        uint8_t begin = end - 1;
+        while (begin > 0 and bands[m_order[begin - 1]] == band) {
+          begin -= 1;
+        }
+        emit_band(begin, end);
+        end = begin;
+      }
+    } else {
+      uint8_t begin = 0;
+      while (begin < capacity) {
+        uint8_t const band = bands[m_order[begin]];
+        uint8_t end = begin + 1;
+        while (end < capacity and bands[m_order[end]] == band) {
+          end += 1;
+        }
+        emit_band(begin, end);
+        begin = end;
+      }
+    }
+    m_is_bottom_to_top = not m_is_bottom_to_top;
+  }
+};
+} // namespace libgb
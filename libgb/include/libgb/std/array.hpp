@@ -2,6 +2,7 @@
 
 #include <stddef.h>
 
+#include <libgb/std/memcpy.hpp>
 #include <libgb/std/traits.hpp>
 
 namespace libgb {
@@ -18,6 +19,14 @@ template <typename T, size_t Size> struct Array {
 
   template <typename Self>
   constexpr auto operator==(this Self const &self, Array const &other) {
+    if !consteval {
+      if constexpr (is_bytewise_comparable<T>) {
+        return libgb::memcmp((uint8_t const *)self.m_data,
+                             (uint8_t const *)other.m_data,
+                             sizeof(self.m_data)) == 0;
+      }
+    }
+
     for (size_t i = 0; i < Size; i += 1) {
       if (self.m_data[i] != other.m_data[i]) {
         return false;
@@ -17,4 +17,12 @@ constexpr auto next_power_of_two_mask(uint8_t value) -> int8_t {
   value |= value >> 4;
   return value;
 }
+
+template <typename T> constexpr auto min(T lhs, T rhs) -> T {
+  return rhs < lhs ? rhs : lhs;
+}
+
+template <typename T> constexpr auto max(T lhs, T rhs) -> T {
+  return lhs < rhs ? rhs : lhs;
+}
 } // namespace libgb
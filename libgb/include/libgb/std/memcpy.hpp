@@ -4,17 +4,249 @@
 #include <stdint.h>
 
 namespace libgb {
+namespace impl {
+extern "C" {
+// Defined in memcpy.S
+auto memmove(void *dst, void const *src, size_t count) -> void *;
+auto memcmp(void const *lhs, void const *rhs, size_t count) -> int;
+auto memchr(void const *ptr, int byte, size_t count) -> void *;
+
+// 8x unrolled kernels, these pay ~50 cycles of setup to save ~3.5 cycles per
+// byte.
+auto __libgb_memcpy_unrolled(void *dst, void const *src, size_t count)
+    -> void *;
+auto __libgb_memset_unrolled(void *dst, int byte, size_t count) -> void *;
+
+// Entry points into straight-line `ldi` sequences, each copies/ sets exactly N
+// bytes. There is no count argument, so callers don't have to load de.
+#define LIBGB_FOR_EACH_STRAIGHT_LINE_SIZE(X)                                   \
+  X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14)   \
+      X(15) X(16) X(17) X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26)  \
+          X(27) X(28) X(29) X(30) X(31) X(32)
+
+#define LIBGB_DECLARE_STRAIGHT_LINE(N)                                         \
+  auto __libgb_memcpy_n_##N(void *dst, void const *src) -> void *;            \
+  auto __libgb_memset_n_##N(void *dst, int byte) -> void *;
+LIBGB_FOR_EACH_STRAIGHT_LINE_SIZE(LIBGB_DECLARE_STRAIGHT_LINE)
+#undef LIBGB_DECLARE_STRAIGHT_LINE
+
+// Entry points into the page-local kernels, N is the number of bytes copied on
+// the first pass. The count is the number of 8 byte passes.
+#define LIBGB_DECLARE_PAGED(N)                                                 \
+  auto __libgb_memcpy_paged_##N(void *dst, void const *src, size_t passes)    \
+      -> void *;                                                               \
+  auto __libgb_memset_paged_##N(void *dst, int byte, size_t passes) -> void *;
+LIBGB_DECLARE_PAGED(1)
+LIBGB_DECLARE_PAGED(2)
+LIBGB_DECLARE_PAGED(3)
+LIBGB_DECLARE_PAGED(4)
+LIBGB_DECLARE_PAGED(5)
+LIBGB_DECLARE_PAGED(6)
+LIBGB_DECLARE_PAGED(7)
+LIBGB_DECLARE_PAGED(8)
+#undef LIBGB_DECLARE_PAGED
+
+// Defined in stack_blit.S
+auto __libgb_stack_blit(void *dst, void const *src, size_t count) -> void *;
+}
+
+// Below this size the setup of the unrolled kernels costs more than it saves
+static constexpr size_t unrolled_copy_threshold = 16;
+
+// Above this size memcpy_n/ memset_n fall back to the unrolled kernels
+static constexpr size_t straight_line_copy_limit = 32;
+
+using MemcpyKernel = auto (*)(void *, void const *, size_t) -> void *;
+using MemsetKernel = auto (*)(void *, int, size_t) -> void *;
+using StraightLineMemcpyKernel = auto (*)(void *, void const *) -> void *;
+using StraightLineMemsetKernel = auto (*)(void *, int) -> void *;
+
+#define LIBGB_STRAIGHT_LINE_MEMCPY(N) __libgb_memcpy_n_##N,
+#define LIBGB_STRAIGHT_LINE_MEMSET(N) __libgb_memset_n_##N,
+static constexpr StraightLineMemcpyKernel straight_line_memcpy[] = {
+    nullptr, LIBGB_FOR_EACH_STRAIGHT_LINE_SIZE(LIBGB_STRAIGHT_LINE_MEMCPY)};
+static constexpr StraightLineMemsetKernel straight_line_memset[] = {
+    nullptr, LIBGB_FOR_EACH_STRAIGHT_LINE_SIZE(LIBGB_STRAIGHT_LINE_MEMSET)};
+#undef LIBGB_STRAIGHT_LINE_MEMSET
+#undef LIBGB_STRAIGHT_LINE_MEMCPY
+#undef LIBGB_FOR_EACH_STRAIGHT_LINE_SIZE
+
+static_assert(sizeof(straight_line_memcpy) /
+                  sizeof(StraightLineMemcpyKernel) ==
+              straight_line_copy_limit + 1);
+
+static constexpr size_t page_size = 256;
+
+static constexpr MemcpyKernel paged_memcpy[] = {
+    nullptr,
+    __libgb_memcpy_paged_1,
+    __libgb_memcpy_paged_2,
+    __libgb_memcpy_paged_3,
+    __libgb_memcpy_paged_4,
+    __libgb_memcpy_paged_5,
+    __libgb_memcpy_paged_6,
+    __libgb_memcpy_paged_7,
+    __libgb_memcpy_paged_8,
+};
+static constexpr MemsetKernel paged_memset[] = {
+    nullptr,
+    __libgb_memset_paged_1,
+    __libgb_memset_paged_2,
+    __libgb_memset_paged_3,
+    __libgb_memset_paged_4,
+    __libgb_memset_paged_5,
+    __libgb_memset_paged_6,
+    __libgb_memset_paged_7,
+    __libgb_memset_paged_8,
+};
+} // namespace impl
+
+// Whether interrupts are enabled around a call, for routines that have to
+// hold them off. The SM83 can't read IME back, so the caller has to say.
+enum class InterruptState : uint8_t {
+  enabled,
+  disabled,
+};
+
+// Places T at the start of a 256 byte page. Copies between two PageAligned
+// objects never carry into the high byte of the address, which lets
+// libgb::memcpy/ memset pick the cheaper page-local kernels.
+template <typename T> struct [[gnu::aligned(impl::page_size)]] PageAligned {
+  static_assert(sizeof(T) <= impl::page_size,
+                "PageAligned<T> must fit in a single page");
+
+  T value;
+
+  template <typename Self>
+  constexpr auto operator[](this Self &&self, size_t index) -> decltype(auto) {
+    return self.value[index];
+  }
+};
+
 template <typename To, typename From>
 constexpr auto bit_cast(From const &from) -> To {
   return __builtin_bit_cast(To, from);
 }
 
-inline auto memcpy(uint8_t volatile *dst, uint8_t const *src, size_t count)
+[[gnu::always_inline]] inline auto
+memcpy(uint8_t volatile *dst, uint8_t const *src, size_t count) -> void {
+  if (__builtin_constant_p(count) && count < impl::unrolled_copy_threshold) {
+    __builtin_memcpy((void *)dst, src, count);
+  } else {
+    impl::__libgb_memcpy_unrolled((void *)dst, src, count);
+  }
+}
+
+[[gnu::always_inline]] inline auto memset(uint8_t volatile *dst, uint8_t byte,
+                                          size_t count) -> void {
+  if (__builtin_constant_p(count) && count < impl::unrolled_copy_threshold) {
+    __builtin_memset((void *)dst, byte, count);
+  } else {
+    impl::__libgb_memset_unrolled((void *)dst, byte, count);
+  }
+}
+
+// Safe for overlapping ranges, copies backwards when dst is above src.
+[[gnu::always_inline]] inline auto memmove(uint8_t volatile *dst,
+                                           uint8_t const *src, size_t count)
     -> void {
-  __builtin_memcpy((void *)dst, src, count);
+  impl::memmove((void *)dst, src, count);
+}
+
+[[gnu::always_inline]] inline auto memcmp(uint8_t const *lhs,
+                                          uint8_t const *rhs, size_t count)
+    -> int {
+  return impl::memcmp(lhs, rhs, count);
+}
+
+// Returns nullptr if byte isn't found in the first count bytes
+[[gnu::always_inline]] inline auto memchr(uint8_t const *ptr, uint8_t byte,
+                                          size_t count) -> uint8_t const * {
+  return (uint8_t const *)impl::memchr(ptr, byte, count);
+}
+
+// Copies with a compile-time size skip the loop setup entirely. Small copies
+// jump straight into an unrolled `ldi` sequence.
+template <size_t N>
+[[gnu::always_inline]] inline auto memcpy_n(uint8_t volatile *dst,
+                                            uint8_t const *src) -> void {
+  if constexpr (N == 0) {
+    return;
+  } else if constexpr (N <= impl::straight_line_copy_limit) {
+    constexpr auto kernel = impl::straight_line_memcpy[N];
+    kernel((void *)dst, src);
+  } else {
+    impl::__libgb_memcpy_unrolled((void *)dst, src, N);
+  }
+}
+
+template <size_t N>
+[[gnu::always_inline]] inline auto memset_n(uint8_t volatile *dst,
+                                            uint8_t byte) -> void {
+  if constexpr (N == 0) {
+    return;
+  } else if constexpr (N <= impl::straight_line_copy_limit) {
+    constexpr auto kernel = impl::straight_line_memset[N];
+    kernel((void *)dst, byte);
+  } else {
+    impl::__libgb_memset_unrolled((void *)dst, byte, N);
+  }
+}
+
+// Copies N bytes from a source that doesn't cross a 256 byte page. The source
+// only needs `inc c` (~5.5 cycles per byte) and there is no loop setup.
+template <size_t N>
+[[gnu::always_inline]] inline auto memcpy_paged(uint8_t volatile *dst,
+                                                uint8_t const *src) -> void {
+  static_assert(N <= impl::page_size);
+  if constexpr (N == 0) {
+    return;
+  } else {
+    constexpr auto kernel = impl::paged_memcpy[(N - 1) % 8 + 1];
+    kernel((void *)dst, src, (N + 7) / 8);
+  }
+}
+
+// There is nothing to gain from the alignment here, `ldi (hl), a` is already
+// as cheap as it gets. What's left is the 8-bit counter and the lack of setup.
+template <size_t N>
+[[gnu::always_inline]] inline auto memset_paged(uint8_t volatile *dst,
+                                                uint8_t byte) -> void {
+  static_assert(N <= impl::page_size);
+  if constexpr (N == 0) {
+    return;
+  } else {
+    constexpr auto kernel = impl::paged_memset[(N - 1) % 8 + 1];
+    kernel((void *)dst, byte, (N + 7) / 8);
+  }
+}
+
+template <typename T>
+[[gnu::always_inline]] inline auto memcpy(PageAligned<T> volatile &dst,
+                                          PageAligned<T> const &src) -> void {
+  memcpy_paged<sizeof(T)>((uint8_t volatile *)&dst.value,
+                          (uint8_t const *)&src.value);
+}
+
+template <typename T>
+[[gnu::always_inline]] inline auto memset(PageAligned<T> volatile &dst,
+                                          uint8_t byte) -> void {
+  memset_paged<sizeof(T)>((uint8_t volatile *)&dst.value, byte);
 }
 
-inline auto memset(uint8_t volatile *dst, uint8_t byte, size_t count) -> void {
-  __builtin_memset((void *)dst, byte, count);
+// Copies 2 bytes per `pop`, ~4.75 cycles per byte instead of ~6.5 once the
+// setup is paid for. Only worth it for long runs, a single 16 byte tile is
+// faster with memcpy_n.
+// Interrupts are held off for the whole copy, and only turned back on after it
+// when state says they were on. The destination must stay writable without any
+// help from an interrupt (e.g. the LCD is off). This does *not* play well with
+// ScopedVRAMGuard.
+template <InterruptState state = InterruptState::enabled>
+[[gnu::always_inline]] inline auto
+stack_blit(uint8_t volatile *dst, uint8_t const *src, size_t count) -> void {
+  impl::__libgb_stack_blit((void *)dst, src, count);
+  if constexpr (state == InterruptState::enabled) {
+    asm volatile("ei" ::: "memory");
+  }
 }
 } // namespace libgb
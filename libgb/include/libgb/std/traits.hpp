@@ -121,6 +121,10 @@ concept is_unsigned_integer = is_unsigned_integer_t<T>::value;
 template <typename T>
 concept is_integral = is_signed_integer<T> || is_unsigned_integer<T>;
 
+// Types whose equality is exactly equality of their bytes
+template <typename T>
+concept is_bytewise_comparable = is_integral<T> || is_enum<T>;
+
 template <typename T>
 concept is_iterator = requires(T t) {
   ++t;
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/dimensions.hpp>
+#include <libgb/format.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/assert.hpp>
+#include <libgb/std/fixed_vector.hpp>
+#include <libgb/std/math.hpp>
+#include <libgb/std/memcpy.hpp>
+#include <libgb/std/traits.hpp>
+#include <libgb/tile_allocation.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libgb {
+// A monospace font, one tile per character from first_char onwards
+template <size_t GlyphCount> struct Font {
+  char first_char;
+  libgb::Array<arch::Tile, GlyphCount> glyphs;
+
+  [[nodiscard]] constexpr auto glyph_index(char c) const -> uint8_t {
+    auto const index = (uint8_t)(c - first_char);
+    assert(index < GlyphCount);
+    return index;
+  }
+
+  // For ResidentGlyphs
+  template <typename Registry>
+  consteval auto register_tiles(Registry &registry, Scene &scene) const
+      -> void {
+    for (auto const &glyph : glyphs) {
+      scene.register_background_tile(registry, glyph);
+    }
+  }
+};
+
+// Every glyph of the font stays in VRAM, see Font::register_tiles()
+template <SceneManager all_scenes, size_t scene_index, auto const &font>
+class ResidentGlyphs {
+  static constexpr auto tiles = [] {
+    libgb::Array<TileIndex, font.glyphs.size()> result = {};
+    for (auto const &[index, glyph] : enumerate(font.glyphs)) {
+      result[index] = all_scenes.background_tile_index(scene_index, glyph);
+    }
+    return result;
+  }();
+
+public:
+  auto acquire(char c) -> TileIndex { return tiles[font.glyph_index(c)]; }
+  auto release(char) -> void {}
+  auto flush(uint16_t) -> bool { return true; }
+  // The glyphs are uploaded along with the scene
+  auto invalidate() -> void {}
+};
+
+// For fonts that don't fit in VRAM. Glyphs are uploaded into the slots kept
+// with Scene::reserve_background_tiles() when first shown. A slot is only
+// reused once no cell shows it, least recently used first.
+// Scene uploads leave reserved slots alone, but another scene may have put its
+// own tiles there. Call invalidate() after switching back to the scene.
+template <SceneManager all_scenes, size_t scene_index, auto const &font>
+class GlyphCache {
+  static constexpr auto slots =
+      to_array<all_scenes.reserved_background_tiles(scene_index)>();
+  static constexpr uint8_t slot_count = slots.size();
+  static_assert(slot_count != 0, "The scene has no reserved background tiles");
+
+  // Glyph index + 1, 0 for empty slots
+  libgb::Array<uint8_t, slot_count> m_glyphs = {};
+  // The number of cells showing each slot, a full screen has more than 255
+  libgb::Array<uint16_t, slot_count> m_users = {};
+  libgb::Array<uint16_t, slot_count> m_last_used = {};
+  libgb::Array<bool, slot_count> m_is_stale = {};
+  uint16_t m_clock = 0;
+
+  // Compared instead of the timestamps, so m_clock can wrap around
+  [[nodiscard]] auto age(uint8_t slot) const -> uint16_t {
+    return (uint16_t)(m_clock - m_last_used[slot]);
+  }
+
+  [[nodiscard]] auto find(uint8_t glyph) const -> uint8_t {
+    for (uint8_t slot = 0; slot < slot_count; slot += 1) {
+      if (m_glyphs[slot] == glyph) {
+        return slot;
+      }
+    }
+    return slot_count;
+  }
+
+public:
+  auto acquire(char c) -> TileIndex {
+    uint8_t const glyph = font.glyph_index(c) + 1;
+    m_clock += 1;
+
+    uint8_t slot = find(glyph);
+    if (slot == slot_count) {
+      for (uint8_t other = 0; other < slot_count; other += 1) {
+        if (m_users[other] == 0 and
+            (slot == slot_count or age(other) > age(slot))) {
+          slot = other;
+        }
+      }
+      // Every slot is on screen, more tiles need to be reserved
+      assert(slot != slot_count);
+      m_glyphs[slot] = glyph;
+      m_is_stale[slot] = true;
+    }
+    m_users[slot] += 1;
+    m_last_used[slot] = m_clock;
+    return slots[slot];
+  }
+
+  auto release(char c) -> void {
+    uint8_t const slot = find(font.glyph_index(c) + 1);
+    m_users[slot] -= 1;
+    m_last_used[slot] = m_clock;
+  }
+
+  // The next flush uploads every glyph in the cache again
+  auto invalidate() -> void {
+    for (uint8_t slot = 0; slot < slot_count; slot += 1) {
+      m_is_stale[slot] = m_glyphs[slot] != 0;
+    }
+  }
+
+  // Uploads the glyphs loaded since the last flush, as many as fit in budget
+  // M-cycles. The rest are carried over to the next flush. Returns whether
+  // every glyph is up to date, VRAM must be accessible.
+  auto flush(uint16_t budget) -> bool {
+    for (uint8_t slot = 0; slot < slot_count; slot += 1) {
+      if (not m_is_stale[slot]) {
+        continue;
+      }
+      if (budget < tile_upload_cost) {
+        return false;
+      }
+      budget -= tile_upload_cost;
+      m_is_stale[slot] = false;
+      set_tile_data(
+          tile_address(slots[slot], TileAddressingMode::bg_window_signed),
+          font.glyphs[m_glyphs[slot] - 1]);
+    }
+    return true;
+  }
+};
+
+// A width x height block of text in a tile map, e.g. a score counter:
+//
+//   hud.print<"SCORE {}">(libgb::Tiles{0}, libgb::Tiles{0}, score);
+//   ...
+//   // From vblank
+//   hud.flush<libgb::TileMap::map_0>(libgb::Tiles{0}, libgb::Tiles{12},
+//                                    budget);
+//
+// Only cells whose character changed are touched, flush() uploads the span
+// between the first and last changed cell of each row. Numbers are written in
+// decimal. The background must use signed tile addressing.
+template <Tiles width, Tiles height, typename Glyphs> class TextLayer {
+  using Row = libgb::Array<TileIndex, +width>;
+
+  Glyphs m_glyphs = {};
+  // '\0' for cells that were never written
+  libgb::Array<libgb::Array<char, +width>, +height> m_text = {};
+  libgb::Array<Row, +height> m_tiles = {};
+  // The columns [start, end) of each row need uploading
+  libgb::Array<uint8_t, +height> m_dirty_start = {};
+  libgb::Array<uint8_t, +height> m_dirty_end = {};
+
+  auto write_decimal(Tiles y, uint8_t &column, uint16_t value) -> void {
+    static constexpr libgb::Array<uint16_t, 5> powers = {
+        10000, 1000, 100, 10, 1};
+    bool has_digits = false;
+    for (auto power : powers) {
+      char digit = '0';
+      while (value >= power) {
+        value -= power;
+        digit += 1;
+      }
+      if (digit != '0' or has_digits or power == 1) {
+        has_digits = true;
+        set(y, Tiles{column}, digit);
+        column += 1;
+      }
+    }
+  }
+
+public:
+  auto set(Tiles y, Tiles x, char c) -> void {
+    assert(c != '\0');
+    // Also catches print() running off the end of the row
+    assert(+x < +width and +y < +height);
+    char &cell = m_text[+y][+x];
+    if (cell == c) {
+      return;
+    }
+    if (cell != '\0') {
+      m_glyphs.release(cell);
+    }
+    cell = c;
+    m_tiles[+y][+x] = m_glyphs.acquire(c);
+
+    uint8_t &start = m_dirty_start[+y];
+    uint8_t &end = m_dirty_end[+y];
+    if (start == end) {
+      start = +x;
+      end = +x + 1;
+    } else {
+      start = min(start, +x);
+      end = max(end, (uint8_t)(+x + 1));
+    }
+  }
+
+  // For when the glyphs' tiles were overwritten, e.g. by another scene
+  auto invalidate() -> void { m_glyphs.invalidate(); }
+
+  // Writes from (y, x) onwards, the text must fit in the row. Returns the
+  // column after the last character.
+  template <impl::FormatString fmt, typename... Args>
+  auto print(Tiles y, Tiles x, Args... args) -> Tiles {
+    static constexpr auto fmt_string =
+        impl::shrink_wrap_format_string<fmt>().m_data;
+    static_assert(fmt.m_args == sizeof...(args),
+                  "print arguments do not match format specifier");
+
+    char const *next = fmt_string.data();
+    uint8_t column = +x;
+    auto const print_section = [&] {
+      for (; *next != impl::format_separator; next += 1) {
+        set(y, Tiles{column}, *next);
+        column += 1;
+      }
+      next += 1;
+    };
+
+    auto const print_arg = [&]<typename Arg>(Arg arg) {
+      print_section();
+      if constexpr (is_same<Arg, char>) {
+        set(y, Tiles{column}, arg);
+        column += 1;
+      } else if constexpr (is_same<Arg, char const *>) {
+        for (; *arg != '\0'; arg += 1) {
+          set(y, Tiles{column}, *arg);
+          column += 1;
+        }
+      } else {
+        static_assert(is_same<Arg, uint8_t> || is_same<Arg, uint16_t>,
+                      "Unsupported print argument");
+        write_decimal(y, column, arg);
+      }
+    };
+
+    (print_arg(args), ...);
+    print_section();
+    return Tiles{column};
+  }
+
+  // Uploads the changed glyphs and cells with (y, x) as the top left corner in
+  // the tile map. VRAM must be accessible, e.g. call this from vblank.
+  // Glyph uploads are limited to budget M-cycles, see GlyphCache::flush(). The
+  // cells wait until all their glyphs are in VRAM, so that none shows a
+  // half-loaded cache.
+  template <TileMap map>
+  auto flush(Tiles y, Tiles x, uint16_t budget) -> void {
+    if (not m_glyphs.flush(budget)) {
+      return;
+    }
+    for (uint8_t row = 0; row < +height; row += 1) {
+      uint8_t const start = m_dirty_start[row];
+      uint8_t const end = m_dirty_end[row];
+      if (start == end) {
+        continue;
+      }
+      m_dirty_start[row] = 0;
+      m_dirty_end[row] = 0;
+
+      memcpy((uint8_t volatile *)&arch::tile_maps->maps[+map]
+                 .data[+y + row][+x + start],
+             (uint8_t const *)&m_tiles[row][start], end - start);
+    }
+  }
+};
+} // namespace libgb
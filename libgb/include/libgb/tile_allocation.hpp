@@ -8,6 +8,9 @@
 #include <libgb/std/assert.hpp>
 #include <libgb/std/fixed_vector.hpp>
 #include <libgb/std/ranges.hpp>
+#include <libgb/std/utility.hpp>
+#include <libgb/tile_builder.hpp>
+#include <libgb/tile_compression.hpp>
 #include <libgb/video.hpp>
 
 #include <stdint.h>
@@ -15,33 +18,88 @@
 namespace libgb {
 enum class TileRegistryIndex : size_t {
   invalid_index = ~0U,
+  // A scene slot kept free for tiles uploaded at runtime, e.g. glyphs
+  reserved_index = ~0U - 1,
+};
+
+// Whether a scene slot holds a tile that's uploaded along with the scene
+constexpr auto is_scene_tile(TileRegistryIndex index) -> bool {
+  return index != TileRegistryIndex::invalid_index and
+         index != TileRegistryIndex::reserved_index;
+}
+
+// A sprite tile along with the flips that turn the stored tile into it
+struct SpriteTile {
+  TileIndex index;
+  bool flip_x;
+  bool flip_y;
+};
+
+struct FlippedTileRegistryIndex {
+  TileRegistryIndex index;
+  bool flip_x;
+  bool flip_y;
 };
 
 struct TileRegistry {
+  // Both halves together fill exactly one 16KiB ROM bank.
+  // TODO: banked tile data, it needs an MBC cartridge (meta.cpp) and a linker
+  // script with switchable bank sections to place it in
   static constexpr auto maximum_tile_count = 512;
-  libgb::FixedVector<arch::Tile, maximum_tile_count> m_all_sprite_tiles = {};
-  libgb::FixedVector<arch::Tile, maximum_tile_count> m_all_background_tiles =
-      {};
+  // Open addressing, kept at most half full so probes stay short
+  static constexpr size_t hash_table_size = 2 * maximum_tile_count;
 
-  consteval auto
-  find_tile(libgb::FixedVector<arch::Tile, maximum_tile_count> const &tiles,
-            arch::Tile const &tile) const -> TileRegistryIndex {
-    for (auto const &[index, other_tile] : enumerate(tiles)) {
-      if (other_tile == tile) {
-        return TileRegistryIndex{index};
+  using Tiles = libgb::FixedVector<arch::Tile, maximum_tile_count>;
+  // Registry index + 1 of the tiles, by hash, 0 for empty buckets
+  using HashTable = libgb::Array<uint16_t, hash_table_size>;
+
+  Tiles m_all_sprite_tiles = {};
+  Tiles m_all_background_tiles = {};
+  HashTable m_sprite_tile_table = {};
+  HashTable m_background_tile_table = {};
+
+  // FNV-1a
+  static consteval auto tile_hash(arch::Tile const &tile) -> size_t {
+    uint32_t hash = 2166136261U;
+    for (auto byte : tile.data) {
+      hash = (hash ^ byte) * 16777619U;
+    }
+    return hash % hash_table_size;
+  }
+
+  consteval auto find_tile(Tiles const &tiles, HashTable const &table,
+                           arch::Tile const &tile) const
+      -> TileRegistryIndex {
+    for (size_t bucket = tile_hash(tile); table[bucket] != 0;
+         bucket = (bucket + 1) % hash_table_size) {
+      if (tiles[table[bucket] - 1] == tile) {
+        return TileRegistryIndex{table[bucket] - 1U};
       }
     }
     return TileRegistryIndex::invalid_index;
   }
 
+  consteval auto add_tile(Tiles &tiles, HashTable &table,
+                          arch::Tile const &tile) -> TileRegistryIndex {
+    auto new_index = tiles.size();
+    tiles.push_back(tile);
+
+    size_t bucket = tile_hash(tile);
+    while (table[bucket] != 0) {
+      bucket = (bucket + 1) % hash_table_size;
+    }
+    table[bucket] = (uint16_t)(new_index + 1);
+    return TileRegistryIndex{new_index};
+  }
+
   consteval auto find_background_tile(arch::Tile const &tile) const
       -> TileRegistryIndex {
-    return find_tile(m_all_background_tiles, tile);
+    return find_tile(m_all_background_tiles, m_background_tile_table, tile);
   }
 
   consteval auto find_sprite_tile(arch::Tile const &tile) const
       -> TileRegistryIndex {
-    return find_tile(m_all_sprite_tiles, tile);
+    return find_tile(m_all_sprite_tiles, m_sprite_tile_table, tile);
   }
 
   consteval auto register_background_tile(arch::Tile const &tile)
@@ -50,22 +108,43 @@ struct TileRegistry {
         found != TileRegistryIndex::invalid_index) {
       return found;
     }
+    return add_tile(m_all_background_tiles, m_background_tile_table, tile);
+  }
 
-    auto new_index = m_all_background_tiles.size();
-    m_all_background_tiles.push_back(tile);
-    return TileRegistryIndex{new_index};
+  // Sprites can be mirrored in hardware, so a tile can also be found as a
+  // flipped version of a stored one. Exact matches take precedence.
+  consteval auto find_flipped_sprite_tile(arch::Tile const &tile) const
+      -> FlippedTileRegistryIndex {
+    for (uint8_t flips = 0; flips < 4; flips += 1) {
+      bool const flip_x = (flips & 1U) != 0;
+      bool const flip_y = (flips & 2U) != 0;
+      auto found =
+          find_sprite_tile(tile_builder::flip_tile(tile, flip_x, flip_y));
+      if (found != TileRegistryIndex::invalid_index) {
+        return {found, flip_x, flip_y};
+      }
+    }
+    return {TileRegistryIndex::invalid_index, false, false};
   }
 
+  // Reuses any stored tile that is a mirror image of this one
   consteval auto register_sprite_tile(arch::Tile const &tile)
       -> TileRegistryIndex {
+    if (auto found = find_flipped_sprite_tile(tile);
+        found.index != TileRegistryIndex::invalid_index) {
+      return found.index;
+    }
+    return add_tile(m_all_sprite_tiles, m_sprite_tile_table, tile);
+  }
+
+  // For 8x16 sprites, flipping those in y would also swap the two halves
+  consteval auto register_unflipped_sprite_tile(arch::Tile const &tile)
+      -> TileRegistryIndex {
     if (auto found = find_sprite_tile(tile);
         found != TileRegistryIndex::invalid_index) {
       return found;
     }
-
-    auto new_index = m_all_sprite_tiles.size();
-    m_all_sprite_tiles.push_back(tile);
-    return TileRegistryIndex{new_index};
+    return add_tile(m_all_sprite_tiles, m_sprite_tile_table, tile);
   }
 };
 
@@ -75,8 +154,23 @@ struct Scene {
 
   libgb::Array<TileRegistryIndex, tiles_per_region> m_sprite_tiles = {};
   libgb::Array<TileRegistryIndex, tiles_per_region> m_background_tiles = {};
+  // 0x8800-0x8fff, reachable from both sprites and the background (in signed
+  // mode) with indices 128-255. Tiles used both ways by a scene go here, once.
+  // Indices into the background tiles of the registry.
+  libgb::Array<TileRegistryIndex, tiles_per_region> m_shared_tiles = {};
+  // 8x16 sprites need their two halves in adjacent slots
+  bool m_has_double_height_sprites = false;
 
-  // TODO: shared tiles
+  // Slot + 1 of every registry index in the region of the same name, 0 when
+  // it isn't there. Slots get freed and rearranged after placement, without
+  // this a miss would have to walk the whole region.
+  using SlotIndex = libgb::Array<uint8_t, TileRegistry::maximum_tile_count>;
+  static_assert(tiles_per_region < 256);
+  SlotIndex m_sprite_slots = {};
+  SlotIndex m_background_slots = {};
+  SlotIndex m_shared_slots = {};
+
+  static constexpr uint8_t first_shared_tile_index = tiles_per_region;
 
   consteval Scene() {
     for (auto &tile : m_sprite_tiles) {
@@ -85,30 +179,48 @@ struct Scene {
     for (auto &tile : m_background_tiles) {
       tile = TileRegistryIndex::invalid_index;
     }
+    for (auto &tile : m_shared_tiles) {
+      tile = TileRegistryIndex::invalid_index;
+    }
   }
 
-  consteval auto find_tile_index(
+  // The slot of tile_id, tiles_per_region if it's not in the region
+  consteval auto find_tile_index(SlotIndex const &slots,
+                                 TileRegistryIndex tile_id) const -> size_t {
+    if (+tile_id >= slots.size() or slots[+tile_id] == 0) {
+      return tiles_per_region;
+    }
+    return slots[+tile_id] - 1U;
+  }
+
+  static consteval auto
+  remove_tile(libgb::Array<TileRegistryIndex, tiles_per_region> &tile_mapping,
+              SlotIndex &slots, size_t slot) -> void {
+    slots[+tile_mapping[slot]] = 0;
+    tile_mapping[slot] = TileRegistryIndex::invalid_index;
+  }
+
+  static consteval auto index_slots(
       libgb::Array<TileRegistryIndex, tiles_per_region> const &tile_mapping,
-      TileRegistryIndex tile_id) const -> size_t {
-    // We allow elements to be deleted (without cascading the correction), we
-    // always need to each the entire map.
-    // This would be equally correct as a linear search, but we might as well
-    // make the happy case (with no hash collision) compile faster.
-    static_assert(remove_ref<decltype(tile_mapping)>::size() < 256);
-    size_t const start_index = +tile_id % tile_mapping.size();
-    size_t search_index = start_index;
-    do {
-      if (tile_id == tile_mapping[search_index]) {
-        return search_index;
+      SlotIndex &slots) -> void {
+    slots = {};
+    for (size_t slot = 0; slot < tiles_per_region; slot += 1) {
+      if (is_scene_tile(tile_mapping[slot])) {
+        slots[+tile_mapping[slot]] = (uint8_t)(slot + 1);
       }
-      search_index = (search_index + 1) % tile_mapping.size();
-    } while (search_index != start_index);
-    return tile_mapping.size();
+    }
+  }
+
+  // For when the slots were rewritten wholesale
+  consteval auto index_all_slots() -> void {
+    index_slots(m_sprite_tiles, m_sprite_slots);
+    index_slots(m_background_tiles, m_background_slots);
+    index_slots(m_shared_tiles, m_shared_slots);
   }
 
   consteval auto
   insert_tile(libgb::Array<TileRegistryIndex, tiles_per_region> &tile_mapping,
-              TileRegistryIndex tile_id) const -> uint8_t {
+              SlotIndex &slots, TileRegistryIndex tile_id) const -> uint8_t {
     // Use the registry index as a placement hint, this allows the tile mapping
     // to remain (relatively) stable between scenes without any expensive
     // placement optimization.
@@ -119,6 +231,7 @@ struct Scene {
       auto &registry_index = tile_mapping[search_index];
       if (registry_index == TileRegistryIndex::invalid_index) {
         registry_index = tile_id;
+        slots[+tile_id] = search_index + 1;
         return search_index;
       }
 
@@ -133,8 +246,8 @@ struct Scene {
 
   consteval auto insert_double_height_tile(
       libgb::Array<TileRegistryIndex, tiles_per_region> &tile_mapping,
-      TileRegistryIndex tile_id_upper, TileRegistryIndex tile_id_lower) const
-      -> uint8_t {
+      SlotIndex &slots, TileRegistryIndex tile_id_upper,
+      TileRegistryIndex tile_id_lower) const -> uint8_t {
     // Use the registry index as a placement hint, this allows the tile mapping
     // to remain (relatively) stable between scenes without any expensive
     // placement optimization.
@@ -148,6 +261,8 @@ struct Scene {
           lower_registry_index == TileRegistryIndex::invalid_index) {
         upper_registry_index = tile_id_upper;
         lower_registry_index = tile_id_lower;
+        slots[+tile_id_upper] = search_index + 1;
+        slots[+tile_id_lower] = search_index + 2;
         return search_index;
       }
 
@@ -161,10 +276,48 @@ struct Scene {
     return assert_unreachable<uint8_t>();
   }
 
+  [[nodiscard]] consteval auto contains(SlotIndex const &slots,
+                                        TileRegistryIndex tile_id) const
+      -> bool {
+    return find_tile_index(slots, tile_id) != tiles_per_region;
+  }
+
+  // The background registry index of a sprite tile, if it's in the shared
+  // region
+  template <typename Registry>
+  consteval auto find_shared_sprite_tile(Registry const &registry,
+                                         TileRegistryIndex sprite_id) const
+      -> TileRegistryIndex {
+    auto const background_id = registry.find_background_tile(
+        registry.m_all_sprite_tiles[+sprite_id]);
+    if (background_id == TileRegistryIndex::invalid_index or
+        not contains(m_shared_slots, background_id)) {
+      return TileRegistryIndex::invalid_index;
+    }
+    return background_id;
+  }
+
   template <typename Registry>
   consteval auto register_background_tile(Registry &registry,
                                           arch::Tile const &tile) -> void {
-    insert_tile(m_background_tiles, registry.register_background_tile(tile));
+    auto const tile_id = registry.register_background_tile(tile);
+    if (contains(m_background_slots, tile_id) or
+        contains(m_shared_slots, tile_id)) {
+      return;
+    }
+
+    // Already used by a sprite, 8x16 halves can't be moved out of their pair
+    auto const sprite_id = registry.find_sprite_tile(tile);
+    if (sprite_id != TileRegistryIndex::invalid_index and
+        not m_has_double_height_sprites) {
+      auto const slot = find_tile_index(m_sprite_slots, sprite_id);
+      if (slot != m_sprite_tiles.size()) {
+        remove_tile(m_sprite_tiles, m_sprite_slots, slot);
+        insert_tile(m_shared_tiles, m_shared_slots, tile_id);
+        return;
+      }
+    }
+    insert_tile(m_background_tiles, m_background_slots, tile_id);
   }
 
   template <typename Registry, size_t width, size_t height>
@@ -182,16 +335,51 @@ struct Scene {
   template <typename Registry>
   consteval auto register_sprite_tile(Registry &registry,
                                       arch::Tile const &tile) -> void {
-    insert_tile(m_sprite_tiles, registry.register_sprite_tile(tile));
+    auto const tile_id = registry.register_sprite_tile(tile);
+    // A mirror image of a tile that's already in the scene
+    if (contains(m_sprite_slots, tile_id) or
+        find_shared_sprite_tile(registry, tile_id) !=
+            TileRegistryIndex::invalid_index) {
+      return;
+    }
+
+    // Already used by the background
+    auto const background_id =
+        registry.find_background_tile(registry.m_all_sprite_tiles[+tile_id]);
+    if (background_id != TileRegistryIndex::invalid_index) {
+      auto const slot = find_tile_index(m_background_slots, background_id);
+      if (slot != m_background_tiles.size()) {
+        remove_tile(m_background_tiles, m_background_slots, slot);
+        insert_tile(m_shared_tiles, m_shared_slots, background_id);
+        return;
+      }
+    }
+    insert_tile(m_sprite_tiles, m_sprite_slots, tile_id);
   }
 
   template <typename Registry>
   consteval auto register_sprite_tiles(Registry &registry,
                                        arch::Tile const &tile_upper,
                                        arch::Tile const &tile_lower) -> void {
-    auto upper_id = registry.register_sprite_tile(tile_upper);
-    auto lower_id = registry.register_sprite_tile(tile_lower);
-    insert_double_height_tile(m_sprite_tiles, upper_id, lower_id);
+    auto upper_id = registry.register_unflipped_sprite_tile(tile_upper);
+    auto lower_id = registry.register_unflipped_sprite_tile(tile_lower);
+    m_has_double_height_sprites = true;
+    insert_double_height_tile(m_sprite_tiles, m_sprite_slots, upper_id,
+                              lower_id);
+  }
+
+  // Keeps count background slots free for tiles uploaded at runtime. They're
+  // taken from the end of the region, away from the placement hints of the
+  // first registered tiles.
+  consteval auto reserve_background_tiles(size_t count) -> void {
+    for (size_t slot = tiles_per_region; slot > 0 and count != 0; slot -= 1) {
+      auto &registry_index = m_background_tiles[slot - 1];
+      if (registry_index == TileRegistryIndex::invalid_index) {
+        registry_index = TileRegistryIndex::reserved_index;
+        count -= 1;
+      }
+    }
+    assert(count == 0);
   }
 
   template <typename Registry>
@@ -203,11 +391,15 @@ struct Scene {
       throw 0;
     }
 
-    for (auto [tile_index, registry_index] :
-         enumerate<uint8_t>(m_background_tiles)) {
-      if (registry_index == target_register_index) {
-        return TileIndex{tile_index};
-      }
+    if (auto const slot =
+            find_tile_index(m_background_slots, target_register_index);
+        slot != m_background_tiles.size()) {
+      return TileIndex{(uint8_t)slot};
+    }
+    if (auto const slot =
+            find_tile_index(m_shared_slots, target_register_index);
+        slot != m_shared_tiles.size()) {
+      return TileIndex{(uint8_t)(first_shared_tile_index + slot)};
     }
     throw 0;
   }
@@ -221,20 +413,37 @@ struct Scene {
   }
 
   template <typename Registry>
-  consteval auto sprite_tile_index(Registry const &registry,
-                                   arch::Tile const &tile) const -> TileIndex {
-    auto target_register_index = registry.find_sprite_tile(tile);
-    if (target_register_index == TileRegistryIndex::invalid_index) {
+  consteval auto sprite_tile(Registry const &registry,
+                             arch::Tile const &tile) const -> SpriteTile {
+    auto target = registry.find_flipped_sprite_tile(tile);
+    if (target.index == TileRegistryIndex::invalid_index) {
       throw 0;
     }
 
-    for (auto [tile_index, registry_index] :
-         enumerate<uint8_t>(m_sprite_tiles)) {
-      if (registry_index == target_register_index) {
-        return TileIndex{tile_index};
-      }
+    if (auto const slot = find_tile_index(m_sprite_slots, target.index);
+        slot != m_sprite_tiles.size()) {
+      return SpriteTile{TileIndex{(uint8_t)slot}, target.flip_x,
+                        target.flip_y};
     }
-    throw 0;
+
+    auto const shared_id = find_shared_sprite_tile(registry, target.index);
+    if (shared_id == TileRegistryIndex::invalid_index) {
+      throw 0;
+    }
+    auto const slot = find_tile_index(m_shared_slots, shared_id);
+    return SpriteTile{TileIndex{(uint8_t)(first_shared_tile_index + slot)},
+                      target.flip_x, target.flip_y};
+  }
+
+  template <typename Registry>
+  consteval auto sprite_tile_index(Registry const &registry,
+                                   arch::Tile const &tile) const -> TileIndex {
+    auto const result = sprite_tile(registry, tile);
+    // The tile is stored mirrored, use sprite_tile() to get the flips
+    if (result.flip_x or result.flip_y) {
+      throw 0;
+    }
+    return result.index;
   }
 
   template <typename Registry>
@@ -246,6 +455,146 @@ struct Scene {
   }
 };
 
+struct SceneTransition {
+  size_t from;
+  size_t to;
+};
+
+namespace impl {
+// The slots of `to` that don't already hold the right tile after `from`
+consteval auto changed_scene_slots(Scene const &from, Scene const &to)
+    -> Scene {
+  Scene result = to;
+  for (size_t index = 0; index < Scene::tiles_per_region; index += 1) {
+    if (from.m_sprite_tiles[index] == to.m_sprite_tiles[index]) {
+      result.m_sprite_tiles[index] = TileRegistryIndex::invalid_index;
+    }
+    if (from.m_background_tiles[index] == to.m_background_tiles[index]) {
+      result.m_background_tiles[index] = TileRegistryIndex::invalid_index;
+    }
+    if (from.m_shared_tiles[index] == to.m_shared_tiles[index]) {
+      result.m_shared_tiles[index] = TileRegistryIndex::invalid_index;
+    }
+  }
+  result.index_all_slots();
+  return result;
+}
+
+using SceneSlots = libgb::Array<TileRegistryIndex, Scene::tiles_per_region>;
+
+// Places the tiles of one region for all scenes at once. Tiles that appear on
+// both sides of many transitions go first and get a slot that's free in every
+// scene using them, so they never move.
+template <size_t SceneCount, size_t TransitionCount>
+consteval auto
+optimise_region(libgb::Array<SceneSlots, SceneCount> const &scenes,
+                libgb::Array<SceneTransition, TransitionCount> const
+                    &transitions) -> libgb::Array<SceneSlots, SceneCount> {
+  static constexpr size_t slot_count = Scene::tiles_per_region;
+
+  struct TileUsage {
+    TileRegistryIndex tile;
+    libgb::Array<bool, SceneCount> is_used_by;
+    size_t shared_transitions;
+    size_t scene_count;
+  };
+  libgb::FixedVector<TileUsage, slot_count * SceneCount> usages = {};
+
+  for (auto const &[scene_index, slots] : enumerate(scenes)) {
+    for (auto tile : slots) {
+      if (not is_scene_tile(tile)) {
+        continue;
+      }
+      size_t usage_index = 0;
+      while (usage_index < usages.size() and
+             usages[usage_index].tile != tile) {
+        usage_index += 1;
+      }
+      if (usage_index == usages.size()) {
+        usages.push_back(TileUsage{tile, {}, 0, 0});
+      }
+      usages[usage_index].is_used_by[scene_index] = true;
+    }
+  }
+
+  for (auto &usage : usages) {
+    for (auto used : usage.is_used_by) {
+      usage.scene_count += used ? 1 : 0;
+    }
+    for (auto const &transition : transitions) {
+      if (usage.is_used_by[transition.from] and
+          usage.is_used_by[transition.to]) {
+        usage.shared_transitions += 1;
+      }
+    }
+  }
+
+  // Insertion sort, most shared first. Ties keep registry order so the
+  // result is stable.
+  auto const goes_before = [](TileUsage const &lhs, TileUsage const &rhs) {
+    if (lhs.shared_transitions != rhs.shared_transitions) {
+      return lhs.shared_transitions > rhs.shared_transitions;
+    }
+    if (lhs.scene_count != rhs.scene_count) {
+      return lhs.scene_count > rhs.scene_count;
+    }
+    return +lhs.tile < +rhs.tile;
+  };
+  for (size_t index = 1; index < usages.size(); index += 1) {
+    for (size_t other = index; other > 0; other -= 1) {
+      if (not goes_before(usages[other], usages[other - 1])) {
+        break;
+      }
+      swap(usages[other], usages[other - 1]);
+    }
+  }
+
+  // Reserved slots stay where they are
+  libgb::Array<SceneSlots, SceneCount> result = {};
+  for (auto const &[scene_index, slots] : enumerate(scenes)) {
+    for (auto const &[slot, tile] : enumerate(slots)) {
+      result[scene_index][slot] = tile == TileRegistryIndex::reserved_index
+                                      ? tile
+                                      : TileRegistryIndex::invalid_index;
+    }
+  }
+
+  for (auto const &usage : usages) {
+    // The slot free in the most scenes, preferring the old placement hint
+    size_t const hint = +usage.tile % slot_count;
+    size_t best_slot = hint;
+    size_t best_free_count = 0;
+    for (size_t offset = 0; offset < slot_count; offset += 1) {
+      size_t const slot = (hint + offset) % slot_count;
+      size_t free_count = 0;
+      for (size_t scene = 0; scene < SceneCount; scene += 1) {
+        if (usage.is_used_by[scene] and
+            result[scene][slot] == TileRegistryIndex::invalid_index) {
+          free_count += 1;
+        }
+      }
+      if (free_count > best_free_count) {
+        best_slot = slot;
+        best_free_count = free_count;
+      }
+    }
+
+    for (size_t scene = 0; scene < SceneCount; scene += 1) {
+      if (not usage.is_used_by[scene]) {
+        continue;
+      }
+      size_t slot = best_slot;
+      // Already taken in this scene, any free slot will do
+      while (result[scene][slot] != TileRegistryIndex::invalid_index) {
+        slot = (slot + 1) % slot_count;
+      }
+      result[scene][slot] = usage.tile;
+    }
+  }
+  return result;
+}
+} // namespace impl
+
 // TODO: shrinkwrap
 template <size_t SceneCount> struct SceneManager {
   TileRegistry m_tile_registry;
@@ -292,16 +641,94 @@ template <size_t SceneCount> struct SceneManager {
                                    arch::Tile const &tile) const -> TileIndex {
     return m_scenes[scene_id].sprite_tile_index(m_tile_registry, tile);
   }
+
+  consteval auto sprite_tile(size_t scene_id, arch::Tile const &tile) const
+      -> SpriteTile {
+    return m_scenes[scene_id].sprite_tile(m_tile_registry, tile);
+  }
+
+  // The slots kept free with Scene::reserve_background_tiles()
+  consteval auto reserved_background_tiles(size_t scene_id) const
+      -> libgb::FixedVector<TileIndex, Scene::tiles_per_region> {
+    libgb::FixedVector<TileIndex, Scene::tiles_per_region> result = {};
+    for (auto const &[slot, tile] :
+         enumerate<uint8_t>(m_scenes[scene_id].m_background_tiles)) {
+      if (tile == TileRegistryIndex::reserved_index) {
+        result.push_back(TileIndex{slot});
+      }
+    }
+    return result;
+  }
+
+  // Bytes written to VRAM by transition_scene<*this, from, to>
+  consteval auto transition_upload_size(SceneTransition transition) const
+      -> size_t {
+    auto const changes = impl::changed_scene_slots(m_scenes[transition.from],
+                                                   m_scenes[transition.to]);
+    size_t tile_count = 0;
+    for (size_t index = 0; index < Scene::tiles_per_region; index += 1) {
+      tile_count += is_scene_tile(changes.m_sprite_tiles[index]) ? 1 : 0;
+      tile_count += is_scene_tile(changes.m_background_tiles[index]) ? 1 : 0;
+      tile_count += is_scene_tile(changes.m_shared_tiles[index]) ? 1 : 0;
+    }
+    return tile_count * sizeof(arch::Tile);
+  }
+
+  template <size_t TransitionCount>
+  consteval auto transition_upload_sizes(
+      libgb::Array<SceneTransition, TransitionCount> const &transitions) const
+      -> libgb::Array<size_t, TransitionCount> {
+    libgb::Array<size_t, TransitionCount> result = {};
+    for (auto const &[index, transition] : enumerate(transitions)) {
+      result[index] = transition_upload_size(transition);
+    }
+    return result;
+  }
+
+  // Optional, replaces the greedy per-scene placement with one that minimises
+  // the bytes uploaded over the given transitions. 8x16 sprites keep the
+  // greedy placement, their halves must stay paired.
+  template <size_t TransitionCount>
+  consteval auto optimise_placement(
+      libgb::Array<SceneTransition, TransitionCount> const &transitions) const
+      -> SceneManager {
+    SceneManager result = *this;
+
+    libgb::Array<impl::SceneSlots, SceneCount> background_slots = {};
+    libgb::Array<impl::SceneSlots, SceneCount> sprite_slots = {};
+    libgb::Array<impl::SceneSlots, SceneCount> shared_slots = {};
+    bool has_double_height_sprites = false;
+    for (auto const &[index, scene] : enumerate(m_scenes)) {
+      background_slots[index] = scene.m_background_tiles;
+      sprite_slots[index] = scene.m_sprite_tiles;
+      shared_slots[index] = scene.m_shared_tiles;
+      has_double_height_sprites |= scene.m_has_double_height_sprites;
+    }
+
+    background_slots = impl::optimise_region(background_slots, transitions);
+    shared_slots = impl::optimise_region(shared_slots, transitions);
+    if (not has_double_height_sprites) {
+      sprite_slots = impl::optimise_region(sprite_slots, transitions);
+    }
+    for (size_t index = 0; index < SceneCount; index += 1) {
+      result.m_scenes[index].m_background_tiles = background_slots[index];
+      result.m_scenes[index].m_sprite_tiles = sprite_slots[index];
+      result.m_scenes[index].m_shared_tiles = shared_slots[index];
+      result.m_scenes[index].index_all_slots();
+    }
+    return result;
+  }
 };
 
 template <typename... Scenes>
 SceneManager(TileRegistry, Scenes... scenes) -> SceneManager<sizeof...(Scenes)>;
 
 namespace impl {
-template <Scene scene, size_t AllTileCount>
-[[gnu::always_inline]] inline auto setup_scene_tile_mapping(
-    libgb::Array<libgb::arch::Tile, AllTileCount> const &all_tile_data,
-    size_t sprite_offset, size_t background_offset) -> void {
+// Calls upload(address, tile) for every tile of the scene, tile being an index
+// into the sprite tiles followed by the background tiles of the registry
+template <Scene scene, typename Upload>
+[[gnu::always_inline]] inline auto
+for_each_scene_tile(size_t background_offset, Upload &&upload) -> void {
   static constexpr auto sprite_mapping =
       transform(scene.m_sprite_tiles, [&](size_t index,
                                           TileRegistryIndex registry_index) {
@@ -318,17 +745,110 @@ template <Scene scene, size_t AllTileCount>
         return Pair<TileRegistryIndex, TileAddress>{registry_index, address};
       });
 
+  static constexpr auto shared_mapping =
+      transform(scene.m_shared_tiles, [](size_t index,
+                                         TileRegistryIndex registry_index) {
+        auto address = libgb::tile_address(
+            TileIndex{(uint8_t)(Scene::first_shared_tile_index + index)},
+            TileAddressingMode::object);
+        return Pair<TileRegistryIndex, TileAddress>{registry_index, address};
+      });
+
 #pragma clang loop unroll(full)
   for (auto [tile, tile_address] : sprite_mapping) {
-    if (tile != TileRegistryIndex::invalid_index) {
-      set_tile_data(tile_address, all_tile_data[+tile + sprite_offset]);
+    if (is_scene_tile(tile)) {
+      upload(tile_address, +tile);
     }
   }
 
 #pragma clang loop unroll(full)
   for (auto [tile, tile_address] : bg_mapping) {
-    if (tile != TileRegistryIndex::invalid_index) {
-      set_tile_data(tile_address, all_tile_data[+tile + background_offset]);
+    if (is_scene_tile(tile)) {
+      upload(tile_address, +tile + background_offset);
+    }
+  }
+
+#pragma clang loop unroll(full)
+  for (auto [tile, tile_address] : shared_mapping) {
+    if (is_scene_tile(tile)) {
+      upload(tile_address, +tile + background_offset);
+    }
+  }
+}
+
+template <Scene scene, size_t AllTileCount>
+[[gnu::always_inline]] inline auto setup_scene_tile_mapping(
+    libgb::Array<libgb::arch::Tile, AllTileCount> const &all_tile_data,
+    size_t background_offset) -> void {
+  for_each_scene_tile<scene>(
+      background_offset, [&](TileAddress tile_address, size_t tile) {
+        set_tile_data(tile_address, all_tile_data[tile]);
+      });
+}
+
+// Consecutive VRAM slots holding consecutive tiles of all_tile_data
+struct SceneTileRun {
+  TileAddress address;
+  uint16_t first_tile;
+  uint16_t tile_count;
+};
+
+// A single tile is faster with memcpy_n, longer runs pay for the setup of
+// stack_blit
+static constexpr size_t stack_blit_minimum_run = 2;
+
+template <Scene scene, size_t background_offset>
+consteval auto find_scene_tile_runs() {
+  libgb::FixedVector<SceneTileRun, 3 * Scene::tiles_per_region> result = {};
+  auto const add_region = [&](SceneSlots const &mapping, size_t offset,
+                              TileAddressingMode mode,
+                              uint8_t first_tile_index) {
+    for (size_t index = 0; index < Scene::tiles_per_region; index += 1) {
+      if (not is_scene_tile(mapping[index])) {
+        continue;
+      }
+      auto const tile = (uint16_t)(+mapping[index] + offset);
+      auto const address =
+          tile_address(TileIndex{(uint8_t)(first_tile_index + index)}, mode);
+      if (result.size() != 0) {
+        auto &last = result[result.size() - 1];
+        if (+last.address + last.tile_count * sizeof(arch::Tile) == +address and
+            last.first_tile + last.tile_count == tile) {
+          last.tile_count += 1;
+          continue;
+        }
+      }
+      result.push_back(SceneTileRun{address, tile, 1});
+    }
+  };
+
+  // In address order, a run can carry on from one region into the next
+  add_region(scene.m_sprite_tiles, 0, TileAddressingMode::object, 0);
+  add_region(scene.m_shared_tiles, background_offset,
+             TileAddressingMode::object, Scene::first_shared_tile_index);
+  add_region(scene.m_background_tiles, background_offset,
+             TileAddressingMode::bg_window_signed, 0);
+  return result;
+}
+
+// Only with the LCD off, stack_blit holds off the interrupt ScopedVRAMGuard
+// relies on
+template <Scene scene, size_t background_offset, InterruptState interrupts,
+          size_t AllTileCount>
+[[gnu::always_inline]] inline auto blit_scene_tile_runs(
+    libgb::Array<libgb::arch::Tile, AllTileCount> const &all_tile_data)
+    -> void {
+  static constexpr auto runs =
+      to_array<find_scene_tile_runs<scene, background_offset>()>();
+
+#pragma clang loop unroll(full)
+  for (auto const &run : runs) {
+    if (run.tile_count < stack_blit_minimum_run) {
+      set_tile_data(run.address, all_tile_data[run.first_tile]);
+    } else {
+      stack_blit<interrupts>((uint8_t volatile *)run.address,
+                             (uint8_t const *)&all_tile_data[run.first_tile],
+                             run.tile_count * sizeof(arch::Tile));
     }
   }
 }
@@ -337,14 +857,169 @@ template <TileRegistry registry>
 static constexpr auto all_tile_data =
     concat(to_array<registry.m_all_sprite_tiles>(),
            to_array<registry.m_all_background_tiles>());
+
+template <Scene scene, TileRegistry registry>
+consteval auto compress_scene_tile_data() {
+  static constexpr size_t slot_count = Scene::tiles_per_region;
+  // At worst every other slot is used, in all three regions
+  TileCompressor<compressed_tile_data_capacity(3 * slot_count,
+                                               3 * slot_count / 2)>
+      compressor;
+  libgb::Array<arch::Tile, slot_count> span_tiles = {};
+
+  // Consecutive slots are consecutive in VRAM, each run of them is a span
+  auto const add_region =
+      [&](libgb::Array<TileRegistryIndex, slot_count> const &mapping,
+          auto const &registry_tiles, TileAddressingMode mode,
+          uint8_t first_tile_index) {
+        size_t index = 0;
+        while (index < slot_count) {
+          if (not is_scene_tile(mapping[index])) {
+            index += 1;
+            continue;
+          }
+
+          size_t count = 0;
+          while (index + count < slot_count and
+                 is_scene_tile(mapping[index + count])) {
+            span_tiles[count] = registry_tiles[+mapping[index + count]];
+            count += 1;
+          }
+          auto const address = tile_address(
+              TileIndex{(uint8_t)(first_tile_index + index)}, mode);
+          compressor.add_span(address, span_tiles.data(), count);
+          index += count;
+        }
+      };
+
+  add_region(scene.m_sprite_tiles, registry.m_all_sprite_tiles,
+             TileAddressingMode::object, 0);
+  add_region(scene.m_background_tiles, registry.m_all_background_tiles,
+             TileAddressingMode::bg_window_signed, 0);
+  add_region(scene.m_shared_tiles, registry.m_all_background_tiles,
+             TileAddressingMode::object, Scene::first_shared_tile_index);
+  compressor.finish();
+  return compressor.m_stream;
+}
+
+template <Scene scene, TileRegistry registry>
+static constexpr auto compressed_scene_tile_data =
+    to_array<compress_scene_tile_data<scene, registry>()>();
+
+template <TileRegistry registry> consteval auto pack_tile_data() {
+  static constexpr auto &tiles = all_tile_data<registry>;
+
+  struct PackedTileData {
+    libgb::FixedVector<arch::Tile, tiles.size()> tiles_2bpp;
+    libgb::FixedVector<arch::Tile1bpp, tiles.size()> tiles_1bpp;
+    // Index into tiles_1bpp if the tile is 1bpp, tiles_2bpp otherwise
+    libgb::Array<Pair<bool, uint16_t>, tiles.size()> locations;
+  };
+
+  PackedTileData result = {};
+  for (auto const &[index, tile] : enumerate(tiles)) {
+    if (tile_builder::is_1bpp(tile)) {
+      result.locations[index] = {true, (uint16_t)result.tiles_1bpp.size()};
+      result.tiles_1bpp.push_back(tile_builder::to_1bpp(tile));
+    } else {
+      result.locations[index] = {false, (uint16_t)result.tiles_2bpp.size()};
+      result.tiles_2bpp.push_back(tile);
+    }
+  }
+  return result;
+}
+
+// Only ever read at compile time, the FixedVectors in it are sized for the
+// whole registry
+template <TileRegistry registry>
+static constexpr auto packed_tile_data = pack_tile_data<registry>();
+
+template <TileRegistry registry>
+static constexpr auto packed_tile_locations =
+    packed_tile_data<registry>.locations;
+
+template <TileRegistry registry>
+static constexpr auto all_2bpp_tile_data =
+    to_array<packed_tile_data<registry>.tiles_2bpp>();
+
+template <TileRegistry registry>
+static constexpr auto all_1bpp_tile_data =
+    to_array<packed_tile_data<registry>.tiles_1bpp>();
 } // namespace impl
 
-template <SceneManager all_scenes, size_t scene_index>
-[[gnu::noinline]] inline auto
-setup_scene_tile_mapping(libgb::ScopedVRAMGuard const &) -> void {
+enum class TileDataFormat : uint8_t {
+  // Tiles are copied as is, shared between all scenes
+  raw,
+  // Each scene gets its own compressed stream, see tile_compression.hpp. Much
+  // smaller in ROM unless scenes share most of their tiles, but slower to set
+  // up.
+  compressed,
+  // Like raw, but tiles with only two colours are stored at 1bpp and expanded
+  // on upload. Half the ROM for those and faster to upload, since half as many
+  // bytes are read.
+  packed,
+};
+
+namespace impl {
+template <Scene scene, TileRegistry registry, TileDataFormat format,
+          InterruptState interrupts, libgb::is_vram_guard Guard>
+[[gnu::always_inline]] inline auto upload_scene_tiles(Guard const &guard)
+    -> void {
+  static constexpr auto background_offset = registry.m_all_sprite_tiles.size();
+  if constexpr (format == TileDataFormat::compressed) {
+    decompress_tile_data(
+        guard, impl::compressed_scene_tile_data<scene, registry>.data());
+  } else if constexpr (format == TileDataFormat::packed) {
+    impl::for_each_scene_tile<scene>(
+        background_offset, [](TileAddress tile_address, size_t tile) {
+          auto const [is_1bpp, index] =
+              impl::packed_tile_locations<registry>[tile];
+          if (is_1bpp) {
+            set_tile_data(tile_address,
+                          impl::all_1bpp_tile_data<registry>[index]);
+          } else {
+            set_tile_data(tile_address,
+                          impl::all_2bpp_tile_data<registry>[index]);
+          }
+        });
+  } else if constexpr (is_same<Guard, ScopedLCDOffGuard>) {
+    impl::blit_scene_tile_runs<scene, background_offset, interrupts>(
+        impl::all_tile_data<registry>);
+  } else {
+    impl::setup_scene_tile_mapping<scene>(impl::all_tile_data<registry>,
+                                          background_offset);
+  }
+}
+} // namespace impl
+
+// Reserved slots are left alone, whatever is cached in them (see GlyphCache)
+// may have been overwritten by an earlier scene and needs invalidating.
+// With ScopedLCDOffGuard, raw tiles in consecutive slots go out with a single
+// stack_blit. interrupts says whether they're on, stack_blit turns them back on
+// after each run only if they were.
+template <SceneManager all_scenes, size_t scene_index,
+          TileDataFormat format = TileDataFormat::raw,
+          InterruptState interrupts = InterruptState::enabled,
+          libgb::is_vram_guard Guard>
+[[gnu::noinline]] inline auto setup_scene_tile_mapping(Guard const &guard)
+    -> void {
   static constexpr auto scene = all_scenes.m_scenes[scene_index];
   static constexpr auto registry = all_scenes.m_tile_registry;
-  impl::setup_scene_tile_mapping<scene>(impl::all_tile_data<registry>, 0,
-                                        registry.m_all_sprite_tiles.size());
+  impl::upload_scene_tiles<scene, registry, format, interrupts>(guard);
+}
+
+// Switches from one scene to another, only uploading the tiles that differ.
+// VRAM must hold the tiles of from_index, e.g. after setup_scene_tile_mapping.
+// As with setup_scene_tile_mapping, caches in reserved slots need
+// invalidating.
+template <SceneManager all_scenes, size_t from_index, size_t to_index,
+          TileDataFormat format = TileDataFormat::raw,
+          InterruptState interrupts = InterruptState::enabled,
+          libgb::is_vram_guard Guard>
+[[gnu::noinline]] inline auto transition_scene(Guard const &guard) -> void {
+  static constexpr auto changes = impl::changed_scene_slots(
+      all_scenes.m_scenes[from_index], all_scenes.m_scenes[to_index]);
+  static constexpr auto registry = all_scenes.m_tile_registry;
+  impl::upload_scene_tiles<changes, registry, format, interrupts>(guard);
 }
 } // namespace libgb
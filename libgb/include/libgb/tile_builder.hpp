@@ -46,4 +46,84 @@ consteval auto build_tile(TileColors colors, Color remap_0 = C0,
   }
   return tile;
 }
+
+// The same tile as drawn with the flip_x/flip_y sprite attributes
+consteval auto flip_tile(arch::Tile const &tile, bool flip_x, bool flip_y)
+    -> arch::Tile {
+  arch::Tile result = {};
+  for (size_t row = 0; row < 8; row += 1) {
+    size_t const source_row = flip_y ? 7 - row : row;
+    for (size_t plane = 0; plane < 2; plane += 1) {
+      uint8_t byte = tile.data[2 * source_row + plane];
+      if (flip_x) {
+        uint8_t reversed = 0;
+        for (size_t bit = 0; bit < 8; bit += 1) {
+          reversed = (reversed << 1U) | ((byte >> bit) & 1U);
+        }
+        byte = reversed;
+      }
+      result.data[2 * row + plane] = byte;
+    }
+  }
+  return result;
+}
+
+consteval auto color_at(arch::Tile const &tile, size_t row, size_t column)
+    -> Color {
+  uint8_t const bit = 7 - column;
+  uint8_t const low = (tile.data[2 * row] >> bit) & 1U;
+  uint8_t const high = (tile.data[2 * row + 1] >> bit) & 1U;
+  return Color(low | (high << 1U));
+}
+
+// Tiles that use at most two colours can be stored as 1bpp, at half the size
+consteval auto is_1bpp(arch::Tile const &tile) -> bool {
+  libgb::Array<bool, 4> is_used = {};
+  uint8_t used_count = 0;
+  for (size_t row = 0; row < 8; row += 1) {
+    for (size_t column = 0; column < 8; column += 1) {
+      auto const color = color_at(tile, row, column);
+      if (not is_used[color]) {
+        is_used[color] = true;
+        used_count += 1;
+      }
+    }
+  }
+  return used_count <= 2;
+}
+
+// The lower colour id is mapped to clear bits, the higher one to set bits
+consteval auto to_1bpp(arch::Tile const &tile) -> arch::Tile1bpp {
+  if (not is_1bpp(tile)) {
+    throw 0;
+  }
+
+  Color off_color = C3;
+  Color on_color = C0;
+  for (size_t row = 0; row < 8; row += 1) {
+    for (size_t column = 0; column < 8; column += 1) {
+      auto const color = color_at(tile, row, column);
+      off_color = color < off_color ? color : off_color;
+      on_color = color > on_color ? color : on_color;
+    }
+  }
+
+  arch::Tile1bpp result = {
+      .rows = {},
+      .colors = (uint8_t)(to_underlying(off_color) * 4U +
+                          to_underlying(on_color)),
+  };
+  for (size_t row = 0; row < 8; row += 1) {
+    uint8_t mask = 0;
+    for (size_t column = 0; column < 8; column += 1) {
+      mask <<= 1;
+      mask |= (color_at(tile, row, column) == on_color and
+               on_color != off_color)
+                  ? 1
+                  : 0;
+    }
+    result.rows[row] = mask;
+  }
+  return result;
+}
 } // namespace libgb::tile_builder
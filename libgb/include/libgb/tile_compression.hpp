@@ -0,0 +1,171 @@
+#pragma once
+
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/assert.hpp>
+#include <libgb/std/fixed_vector.hpp>
+#include <libgb/std/math.hpp>
+#include <libgb/video.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libgb {
+// Compressed tile data, built at compile time and decompressed straight into
+// VRAM. The stream is a list of spans, each covering consecutive tiles:
+//
+//   span:  address (little endian, 0 ends the stream), tokens..., 0x00
+//   token: 0b0nnnnnnn          n literal bytes follow (1-127)
+//          0b10nnnnnn b        b repeated n + 2 times
+//          0b11nnnnnn offset   n + 2 bytes copied from offset + 1 bytes back
+//
+// 2bpp tiles are mostly runs (blank rows, solid planes) and short repeating
+// patterns (the same row twice in a row, or in the previous tile). Back
+// references read what was already written to VRAM, so no WRAM buffer is
+// needed, but they never reach into a previous span.
+namespace impl {
+// Defined in tile_compression.cpp
+auto decompress_tile_data(uint8_t const *stream) -> void;
+
+static constexpr size_t compressed_literal_max = 0x7f;
+static constexpr size_t compressed_run_min = 3;
+static constexpr size_t compressed_run_max = 0x3f + 2;
+static constexpr size_t compressed_window = 256;
+static constexpr uint8_t compressed_run_token = 0x80;
+static constexpr uint8_t compressed_copy_token = 0xc0;
+// The match search only follows a chain of earlier positions whose next
+// compressed_run_min bytes hash the same, and gives up after a few of them
+static constexpr size_t compressed_hash_size = 256;
+static constexpr size_t compressed_max_candidates = 16;
+} // namespace impl
+
+// Worst case size for a stream of up to tile_count tiles in span_count spans
+consteval auto compressed_tile_data_capacity(size_t tile_count,
+                                             size_t span_count) -> size_t {
+  size_t const size = tile_count * sizeof(arch::Tile);
+  return size + size / impl::compressed_literal_max + 1 + span_count * 4 + 2;
+}
+
+template <size_t Capacity> struct TileCompressor {
+  libgb::FixedVector<uint8_t, Capacity> m_stream = {};
+  bool m_is_finished = false;
+
+  consteval auto add_span(TileAddress address, arch::Tile const *tiles,
+                          size_t count) -> void {
+    assert(not m_is_finished);
+    assert(count != 0);
+    m_stream.push_back((uint8_t)+address);
+    m_stream.push_back((uint8_t)(+address >> 8U));
+
+    auto const byte_at = [&](size_t index) -> uint8_t {
+      return tiles[index / sizeof(arch::Tile)].data[index % sizeof(arch::Tile)];
+    };
+    size_t const size = count * sizeof(arch::Tile);
+
+    size_t literal_start = 0;
+    auto const flush_literals = [&](size_t end) {
+      while (literal_start != end) {
+        size_t const length =
+            min(end - literal_start, impl::compressed_literal_max);
+        m_stream.push_back((uint8_t)length);
+        for (size_t i = 0; i < length; i += 1) {
+          m_stream.push_back(byte_at(literal_start + i));
+        }
+        literal_start += length;
+      }
+    };
+
+    // Chain heads and links hold position + 1, 0 ends a chain. Links are kept
+    // for the last window of positions only, older ones are out of reach.
+    libgb::Array<uint16_t, impl::compressed_hash_size> chain_heads = {};
+    libgb::Array<uint16_t, impl::compressed_window> chain_links = {};
+    auto const hash_at = [&](size_t position) -> uint8_t {
+      return (uint8_t)(byte_at(position) * 0x2dU +
+                       byte_at(position + 1) * 0x0bU + byte_at(position + 2));
+    };
+    size_t hashed = 0;
+    auto const hash_until = [&](size_t end) {
+      for (; hashed < end and hashed + impl::compressed_run_min <= size;
+           hashed += 1) {
+        uint8_t const hash = hash_at(hashed);
+        chain_links[hashed % impl::compressed_window] = chain_heads[hash];
+        chain_heads[hash] = (uint16_t)(hashed + 1);
+      }
+    };
+
+    size_t index = 0;
+    while (index < size) {
+      size_t const max_length = min(size - index, impl::compressed_run_max);
+
+      size_t run_length = 1;
+      while (run_length < max_length and
+             byte_at(index + run_length) == byte_at(index)) {
+        run_length += 1;
+      }
+
+      // Matches may overlap with the bytes they produce. Nearer candidates
+      // come first and win ties.
+      size_t copy_length = 0;
+      size_t copy_offset = 0;
+      if (max_length >= impl::compressed_run_min) {
+        hash_until(index);
+        size_t candidate = chain_heads[hash_at(index)];
+        for (size_t tries = 0;
+             candidate != 0 and tries < impl::compressed_max_candidates;
+             tries += 1) {
+          size_t const position = candidate - 1;
+          size_t const offset = index - position;
+          if (offset > impl::compressed_window) {
+            break;
+          }
+          size_t length = 0;
+          while (length < max_length and
+                 byte_at(index + length) == byte_at(position + length)) {
+            length += 1;
+          }
+          if (length > copy_length) {
+            copy_length = length;
+            copy_offset = offset;
+          }
+          candidate = chain_links[position % impl::compressed_window];
+        }
+      }
+
+      if (max(run_length, copy_length) < impl::compressed_run_min) {
+        index += 1;
+        continue;
+      }
+
+      flush_literals(index);
+      if (run_length >= copy_length) {
+        m_stream.push_back(impl::compressed_run_token |
+                           (uint8_t)(run_length - 2));
+        m_stream.push_back(byte_at(index));
+        index += run_length;
+      } else {
+        m_stream.push_back(impl::compressed_copy_token |
+                           (uint8_t)(copy_length - 2));
+        m_stream.push_back((uint8_t)(copy_offset - 1));
+        index += copy_length;
+      }
+      literal_start = index;
+    }
+    flush_literals(size);
+    m_stream.push_back(0);
+  }
+
+  consteval auto finish() -> void {
+    m_stream.push_back(0);
+    m_stream.push_back(0);
+    m_is_finished = true;
+  }
+};
+
+// VRAM must be accessible for reads as well as writes
+template <is_vram_guard Guard>
+inline auto decompress_tile_data(Guard const &, uint8_t const *stream)
+    -> void {
+  impl::decompress_tile_data(stream);
+}
+} // namespace libgb
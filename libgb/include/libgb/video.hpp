@@ -3,6 +3,8 @@
 #include <libgb/arch/enums.hpp>
 #include <libgb/arch/registers.hpp>
 #include <libgb/interrupts.hpp>
+#include <libgb/std/memcpy.hpp>
+#include <libgb/std/traits.hpp>
 
 namespace libgb {
 // Prevents all bus VRAM bus contention issues while in scope.
@@ -37,4 +39,38 @@ struct ScopedVRAMGuard {
 
   ~ScopedVRAMGuard() { disable_lcd_status_interrupt(); }
 };
+
+// Turns the LCD off while in scope, VRAM can then be written at full speed
+// with no timing limits. The screen is blank meanwhile, so this is meant for
+// boot and scene changes.
+// An LCD that is already off, e.g. under an outer guard, is left alone.
+struct ScopedLCDOffGuard {
+  ScopedLCDOffGuard()
+      : m_was_enabled{arch::get_lcd_control_lcd_enable() != 0} {
+    // There is no vblank to wait for when the LCD is already off
+    if (m_was_enabled) {
+      // Turning the LCD off outside of vblank can damage real hardware
+      wait_for_interrupt<libgb::Interrupt::vblank>();
+      arch::set_lcd_control_lcd_enable(false);
+    }
+  }
+
+  ScopedLCDOffGuard(ScopedLCDOffGuard const &) = delete;
+  auto operator=(ScopedLCDOffGuard const &) -> ScopedLCDOffGuard & = delete;
+
+  ~ScopedLCDOffGuard() {
+    if (m_was_enabled) {
+      arch::set_lcd_control_lcd_enable(true);
+    }
+  }
+
+private:
+  bool m_was_enabled;
+};
+
+// Functions that write into VRAM take one of these as proof that it's safe to
+// do so.
+template <typename T>
+concept is_vram_guard =
+    is_same<T, ScopedVRAMGuard> or is_same<T, ScopedLCDOffGuard>;
 } // namespace libgb
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/assert.hpp>
+
+#include <stdint.h>
+
+namespace libgb {
+// Deferred VRAM writes. Gameplay code enqueues writes at any time, the vblank
+// interrupt performs as many of them as fit in the cycle budget and leaves the
+// rest for the next frame:
+//
+//   libgb::wait_for_interrupt<libgb::Interrupt::vblank,
+//                             [] { vram_queue.drain(); }>();
+//
+// Only the interrupt pops and only gameplay code pushes, the indices are
+// volatile so that each side sees the other's progress.
+template <size_t capacity> class VramQueue {
+  static_assert(capacity <= 256 and (capacity & (capacity - 1)) == 0,
+                "VramQueue capacity must be a power of 2 that fits in a byte");
+
+  enum class Kind : uint8_t { byte, tile };
+
+  struct Write {
+    Kind kind;
+    uint8_t value;
+    uint16_t address;
+    arch::Tile const *tile;
+  };
+
+  // Conservative estimate, includes the dispatch in drain(). Tiles cost
+  // tile_upload_cost.
+  static constexpr uint16_t byte_write_cost = 40;
+
+  libgb::Array<Write, capacity> m_writes = {};
+  uint8_t volatile m_start_index = 0;
+  uint8_t volatile m_end_index = 0;
+  uint16_t m_budget = default_budget;
+
+  auto push(Write const &write) -> void {
+    uint8_t const index = m_end_index;
+    uint8_t const next_index = (index + 1) % capacity;
+    // Overflowing the queue would silently drop writes
+    assert(next_index != m_start_index);
+
+    m_writes[index] = write;
+    // The interrupt must not see the new index before the write itself
+    asm volatile("" ::: "memory");
+    m_end_index = next_index;
+  }
+
+public:
+  // vblank lasts ~1140 M-cycles, leave some headroom for the interrupt itself
+  static constexpr uint16_t default_budget = 1100;
+
+  auto set_budget(uint16_t budget) -> void { m_budget = budget; }
+
+  [[nodiscard]] auto empty() const -> bool {
+    return m_start_index == m_end_index;
+  }
+
+  template <TileMap map>
+  auto enqueue_tile_mapping(Tiles y, Tiles x, TileIndex tile) -> void {
+    push(Write{
+        .kind = Kind::byte,
+        .value = +tile,
+        .address = (uint16_t)(uintptr_t)&arch::tile_maps->maps[+map]
+                       .data[+y][+x],
+        .tile = nullptr,
+    });
+  }
+
+  // The tile isn't copied, it must outlive the write (e.g. live in ROM)
+  auto enqueue_tile_data(TileAddress dst, arch::Tile const &src) -> void {
+    push(Write{
+        .kind = Kind::tile,
+        .value = 0,
+        .address = +dst,
+        .tile = &src,
+    });
+  }
+
+  auto enqueue_register(uint16_t address, uint8_t value) -> void {
+    push(Write{
+        .kind = Kind::byte,
+        .value = value,
+        .address = address,
+        .tile = nullptr,
+    });
+  }
+
+  // Must be called from the vblank interrupt
+  auto drain() -> void {
+    uint16_t budget = m_budget;
+    uint8_t index = m_start_index;
+    uint8_t const end_index = m_end_index;
+    while (index != end_index) {
+      auto const &write = m_writes[index];
+      uint16_t const cost =
+          write.kind == Kind::tile ? tile_upload_cost : byte_write_cost;
+      if (cost > budget) {
+        // Carry the rest over to the next frame
+        break;
+      }
+      budget -= cost;
+
+      switch (write.kind) {
+      case Kind::byte:
+        *(uint8_t volatile *)write.address = write.value;
+        break;
+      case Kind::tile:
+        set_tile_data(TileAddress{write.address}, *write.tile);
+        break;
+      }
+      index = (index + 1) % capacity;
+    }
+    m_start_index = index;
+  }
+};
+} // namespace libgb
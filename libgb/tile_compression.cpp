@@ -0,0 +1,39 @@
+#include <libgb/tile_compression.hpp>
+
+#include <stdint.h>
+
+auto libgb::impl::decompress_tile_data(uint8_t const *stream) -> void {
+  while (true) {
+    uint8_t const address_low = *stream++;
+    uint8_t const address_high = *stream++;
+    if (address_high == 0) {
+      return;
+    }
+    auto *dst =
+        (uint8_t volatile *)(uintptr_t)((address_high << 8U) | address_low);
+
+    while (uint8_t const token = *stream++) {
+      if ((token & compressed_run_token) == 0) {
+        uint8_t count = token;
+        do {
+          *dst++ = *stream++;
+        } while (--count != 0);
+        continue;
+      }
+
+      uint8_t count = (token & 0x3fU) + 2;
+      if ((token & compressed_copy_token) == compressed_copy_token) {
+        // Reads back from VRAM, so no staging buffer
+        uint8_t const volatile *src = dst - (*stream++ + 1);
+        do {
+          *dst++ = *src++;
+        } while (--count != 0);
+      } else {
+        uint8_t const value = *stream++;
+        do {
+          *dst++ = value;
+        } while (--count != 0);
+      }
+    }
+  }
+}
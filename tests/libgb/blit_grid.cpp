@@ -0,0 +1,58 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/blit_grid.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/enum.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+// Same shape as the dr_mario board
+static constexpr size_t width = 10;
+static constexpr size_t height = 16;
+static constexpr size_t stride = 16;
+
+libgb::Array<libgb::Array<libgb::TileIndex, stride>, height> grid;
+// Keeps the compiler from folding the source address into the loads
+libgb::TileIndex const *volatile grid_pointer = &grid[0][0];
+
+[[gnu::noinline]] static auto blit(libgb::TileIndex const *src) -> void {
+  libgb::blit_grid<width, height, stride, 0x9c00 + 1, true>(src);
+}
+
+auto check_result() -> int {
+  for (uint8_t row = 0; row < height; row += 1) {
+    auto const &map_row =
+        libgb::arch::tile_maps->maps[1].data[height - row - 1];
+    for (uint8_t column = 0; column < width; column += 1) {
+      if (libgb::to_underlying(map_row[column + 1]) !=
+          libgb::to_underlying(grid[row][column])) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+int main() {
+  libgb::enable_interrupts();
+  for (uint8_t row = 0; row < height; row += 1) {
+    for (uint8_t column = 0; column < stride; column += 1) {
+      grid[row][column] = libgb::TileIndex{(uint8_t)(row * stride + column)};
+    }
+  }
+
+  libgb::ScopedLCDOffGuard guard;
+  auto const *src = grid_pointer;
+
+  // Bounded by the hand written dr_mario asm this replaced, ~1055 cycles
+  // including the call
+  asm volatile("debugtrap" ::: "memory");
+  blit(src);
+  // CHECK: Cycles since last: {{([0-9]?[0-9]?[0-9]|10[0-4][0-9]|105[0-5])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  // CHECK: hl=0000
+  return check_result();
+}
@@ -0,0 +1,65 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/double_buffered_sprite_map.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/sprite_map.hpp>
+#include <libgb/double_buffered_sprite_map.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/sprite_allocator.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+static libgb::DoubleBufferedSpriteMap sprites;
+static libgb::SpriteAllocator allocator;
+
+static constexpr libgb::Metasprite<1> dot = {{{
+    libgb::metasprite_part(0, 0, {libgb::TileIndex{3}, false, false}),
+}}};
+
+static auto dma_on_vblank() -> void {
+  libgb::wait_for_interrupt<libgb::Interrupt::vblank,
+                            [] { sprites.copy_into_active_sprite_map(); }>();
+}
+
+static auto active_pos_y(uint8_t slot) -> uint8_t {
+  libgb::ScopedLCDOffGuard guard;
+  return libgb::arch::active_sprite_map->data[slot].pos_y;
+}
+
+int main() {
+  libgb::enable_interrupts();
+  sprites.start();
+
+  allocator.begin_frame(sprites.back());
+  allocator.draw<dot>(20, 30);
+  allocator.draw<dot>(40, 50);
+  allocator.end_frame();
+  sprites.swap();
+  if (sprites.front()[1].pos_y != 40) {
+    return 1;
+  }
+
+  // Drawing the next frame doesn't touch what gets DMA'd
+  allocator.begin_frame(sprites.back());
+  allocator.draw<dot>(60, 70);
+  allocator.end_frame();
+  dma_on_vblank();
+  if (active_pos_y(0) != 20 or active_pos_y(1) != 40) {
+    return 2;
+  }
+
+  sprites.swap();
+  dma_on_vblank();
+  if (active_pos_y(0) != 60 or active_pos_y(1) != 0) {
+    return 3;
+  }
+
+  // The back buffer still holds the first frame until it is synced
+  sprites.sync_back();
+  if (sprites.back()[0].pos_y != 60 or sprites.back()[1].pos_y != 0) {
+    return 4;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
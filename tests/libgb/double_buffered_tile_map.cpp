@@ -0,0 +1,56 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/double_buffered_tile_map.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/registers.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/double_buffered_tile_map.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+static libgb::DoubleBufferedTileMap background;
+
+static auto is_showing_map_1() -> bool {
+  // The bg tile map bit of lcd_control
+  return (*(uint8_t volatile *)libgb::arch::lcd_control_addr & 0x08U) != 0;
+}
+
+int main() {
+  libgb::enable_interrupts();
+  {
+    libgb::ScopedLCDOffGuard guard;
+    background.start();
+    background.fill(guard, libgb::TileIndex{1});
+  }
+  if (is_showing_map_1()) {
+    return 1;
+  }
+
+  background.present();
+  if (background.front() != libgb::TileMap::map_1 or not is_showing_map_1()) {
+    return 2;
+  }
+
+  // The emulator will throw an error if there is a contested write into VRAM
+  {
+    libgb::ScopedVRAMGuard guard;
+    background.sync_back(guard);
+    background.set(guard, libgb::Tiles{3}, libgb::Tiles{4},
+                   libgb::TileIndex{2});
+  }
+  background.present();
+  if (background.front() != libgb::TileMap::map_0 or is_showing_map_1()) {
+    return 3;
+  }
+
+  libgb::ScopedLCDOffGuard guard;
+  auto const &map = libgb::arch::tile_maps->maps[0];
+  if (map.data[3][4] != libgb::TileIndex{2} or
+      map.data[3][5] != libgb::TileIndex{1}) {
+    return 4;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
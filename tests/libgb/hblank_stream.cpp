@@ -0,0 +1,77 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/hblank_stream.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/hblank_stream.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/memcpy.hpp>
+#include <libgb/video.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Every byte differs from its neighbours, so dropped or reordered chunks show
+static constexpr auto source = [] {
+  libgb::Array<uint8_t, 32 * sizeof(libgb::arch::Tile)> bytes;
+  for (size_t i = 0; i < bytes.size(); i += 1) {
+    bytes[i] = (uint8_t)(i * 7 + 1);
+  }
+  return bytes;
+}();
+
+// Not a multiple of hblank_stream_chunk_size
+static constexpr size_t short_count = 37;
+
+static auto matches_source(uint8_t const volatile *dst, size_t count) -> bool {
+  for (size_t i = 0; i < count; i += 1) {
+    if (dst[i] != source[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  libgb::enable_interrupts();
+
+  auto *const tile_data = (uint8_t volatile *)libgb::tile_address(
+      libgb::TileIndex{0}, libgb::TileAddressingMode::object);
+  // Right after the first stream, and not chunk aligned
+  auto *const short_dst = tile_data + source.size() + 1;
+
+  {
+    // Zeroed, so that a write past the end of the short stream shows
+    libgb::ScopedLCDOffGuard guard;
+    libgb::memset(tile_data, 0, 2 * source.size());
+  }
+
+  // The emulator will throw an error if there is a contested write into VRAM
+  libgb::start_hblank_stream(tile_data, source.data(), source.size());
+
+  // The main loop keeps running while the upload is in flight
+  uint16_t iterations = 0;
+  while (not libgb::is_hblank_stream_done()) {
+    iterations += 1;
+  }
+  if (iterations == 0) {
+    return 1;
+  }
+
+  libgb::start_hblank_stream(short_dst, source.data(), short_count);
+  libgb::wait_for_hblank_stream();
+
+  libgb::ScopedLCDOffGuard guard;
+  if (not matches_source(tile_data, source.size())) {
+    return 2;
+  }
+  if (not matches_source(short_dst, short_count)) {
+    return 3;
+  }
+  if (short_dst[-1] != 0 or short_dst[short_count] != 0) {
+    return 4;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
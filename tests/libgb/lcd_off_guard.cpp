@@ -0,0 +1,61 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/lcd_off_guard.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/registers.hpp>
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+static constexpr auto white_tile = [] {
+  libgb::arch::Tile tile;
+  for (auto &byte : tile.data) {
+    byte = 0xff;
+  }
+  return tile;
+}();
+
+template <libgb::is_vram_guard Guard>
+[[gnu::noinline]] static auto do_large_copy_into_vram() -> void {
+  // The emulator will throw an error if there is a contested write into VRAM
+  Guard guard;
+
+  for (uint8_t tile_index = 1; tile_index != 0; tile_index += 1) {
+    libgb::set_tile_data(
+        libgb::tile_address(libgb::TileIndex{tile_index},
+                            libgb::TileAddressingMode::bg_window_unsigned),
+        white_tile);
+  }
+}
+
+int main() {
+  libgb::enable_interrupts();
+
+  // Only ~1100 of every ~17500 cycles are usable, this takes many frames
+  asm volatile("debugtrap" ::: "memory");
+  do_large_copy_into_vram<libgb::ScopedVRAMGuard>();
+  // CHECK: Cycles since last: {{[0-9][0-9][0-9][0-9][0-9][0-9]+$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  // At most a frame waiting for vblank, then the copy runs flat out
+  do_large_copy_into_vram<libgb::ScopedLCDOffGuard>();
+  // CHECK: Cycles since last: {{[0-9]?[0-9]?[0-9]?[0-9]?[0-9]$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  // An inner guard doesn't wait for a vblank that never comes, and leaves the
+  // LCD off for the outer one
+  {
+    libgb::ScopedLCDOffGuard outer;
+    do_large_copy_into_vram<libgb::ScopedLCDOffGuard>();
+    if (libgb::arch::get_lcd_control_lcd_enable()) {
+      return 1;
+    }
+  }
+  if (not libgb::arch::get_lcd_control_lcd_enable()) {
+    return 2;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
@@ -0,0 +1,77 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/memcmp.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+
+#include <libgb/std/array.hpp>
+#include <libgb/std/memcpy.hpp>
+
+#include <stdint.h>
+
+libgb::Array<uint8_t, 32> lhs;
+libgb::Array<uint8_t, 32> rhs;
+
+volatile int equal_result = 1;
+volatile int greater_result = 0;
+volatile int less_result = 0;
+uint8_t const *volatile found_result = nullptr;
+uint8_t const *volatile missing_result = lhs.data();
+
+auto check_result() -> int {
+  if (equal_result != 0) {
+    return 1;
+  }
+  if (greater_result <= 0) {
+    return 2;
+  }
+  if (less_result >= 0) {
+    return 3;
+  }
+  if (found_result != lhs.data() + 20) {
+    return 4;
+  }
+  if (missing_result != nullptr) {
+    return 5;
+  }
+  if (lhs == rhs) {
+    return 6;
+  }
+  rhs[5] = lhs[5];
+  if (not(lhs == rhs)) {
+    return 7;
+  }
+  return 0;
+}
+
+int main() {
+  for (size_t i = 0; i < lhs.size(); i += 1) {
+    lhs[i] = (uint8_t)i;
+    rhs[i] = (uint8_t)i;
+  }
+
+  // Budgets of 40 cycles plus 16 per byte compared for memcmp and 12 per byte
+  // searched for memchr
+  asm volatile("debugtrap" ::: "memory");
+  equal_result = libgb::memcmp(lhs.data(), rhs.data(), lhs.size());
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|[1-4][0-9][0-9]|5[0-4][0-9]|55[0-2])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  rhs[5] = 0;
+  asm volatile("debugtrap" ::: "memory");
+  greater_result = libgb::memcmp(lhs.data(), rhs.data(), lhs.size());
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|1[0-2][0-9]|13[0-6])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  less_result = libgb::memcmp(rhs.data(), lhs.data(), lhs.size());
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|1[0-2][0-9]|13[0-6])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  found_result = libgb::memchr(lhs.data(), 20, lhs.size());
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|1[0-9][0-9]|2[0-8][0-9]|29[0-2])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  missing_result = libgb::memchr(lhs.data(), 0xFF, lhs.size());
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|[1-3][0-9][0-9]|4[0-1][0-9]|42[0-4])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  // CHECK: hl=0000
+  return check_result();
+}
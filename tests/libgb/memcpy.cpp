@@ -39,38 +39,41 @@ auto check_result() -> int {
   return sentinel ^ 0xEFEF;
 }
 
+// Each count is bounded by what the old one byte per iteration loop measured
+// for the same call (83, 266, 794, 3110, 5158, 1306, 426 and 126 cycles), the
+// unrolled kernels have to beat it at every size.
 int main() {
   asm volatile("debugtrap" ::: "memory");
   libgb::memset(small.data(), 1, small.size());
-  // CHECK: Cycles since last: 83
+  // CHECK: Cycles since last: {{([0-9]|[1-7][0-9]|8[0-3])$}}
   asm volatile("debugtrap" ::: "memory");
 
   libgb::memset(medium.data(), 2, medium.size());
-  // CHECK: Cycles since last: 266
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|1[0-9][0-9]|2[0-5][0-9]|26[0-5])$}}
   asm volatile("debugtrap" ::: "memory");
 
   libgb::memset(large.data(), 3, large.size());
-  // CHECK: Cycles since last: 794
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|[1-6][0-9][0-9]|7[0-8][0-9]|79[0-3])$}}
   asm volatile("debugtrap" ::: "memory");
 
   libgb::memset(very_large.data(), 4, very_large.size());
-  // CHECK: Cycles since last: 3110
+  // CHECK: Cycles since last: {{([0-9]?[0-9]?[0-9]|[1-2][0-9][0-9][0-9]|30[0-9][0-9]|310[0-9])$}}
   asm volatile("debugtrap" ::: "memory");
 
   libgb::memcpy(buffer.data(), very_large.data(), very_large.size());
-  // CHECK: Cycles since last: 5158
+  // CHECK: Cycles since last: {{([0-9]?[0-9]?[0-9]|[1-4][0-9][0-9][0-9]|50[0-9][0-9]|51[0-4][0-9]|515[0-7])$}}
   asm volatile("debugtrap" ::: "memory");
 
   libgb::memcpy(buffer.data(), large.data(), large.size());
-  // CHECK: Cycles since last: 1306
+  // CHECK: Cycles since last: {{([0-9]?[0-9]?[0-9]|1[0-2][0-9][0-9]|130[0-5])$}}
   asm volatile("debugtrap" ::: "memory");
 
   libgb::memcpy(buffer.data(), medium.data(), medium.size());
-  // CHECK: Cycles since last: 426
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|[1-3][0-9][0-9]|4[0-1][0-9]|42[0-5])$}}
   asm volatile("debugtrap" ::: "memory");
 
   libgb::memcpy(buffer.data(), small.data(), small.size());
-  // CHECK: Cycles since last: 126
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|1[0-1][0-9]|12[0-6])$}}
   asm volatile("debugtrap" ::: "memory");
 
   // CHECK: hl=0000
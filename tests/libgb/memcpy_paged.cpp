@@ -0,0 +1,70 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/memcpy_paged.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+
+#include <libgb/std/array.hpp>
+#include <libgb/std/memcpy.hpp>
+
+#include <stdint.h>
+
+libgb::PageAligned<libgb::Array<uint8_t, 160>> oam_sized;
+libgb::PageAligned<libgb::Array<uint8_t, 256>> page_sized;
+
+libgb::PageAligned<libgb::Array<uint8_t, 160>> oam_sized_buffer;
+libgb::PageAligned<libgb::Array<uint8_t, 256>> page_sized_buffer;
+volatile uint16_t sentinel = 0xEFEFU;
+
+auto check_result() -> int {
+  for (size_t i = 0; i < oam_sized_buffer.value.size(); i += 1) {
+    if (oam_sized_buffer[i] != 1) {
+      return 1;
+    }
+  }
+  for (size_t i = 0; i < page_sized_buffer.value.size(); i += 1) {
+    if (page_sized_buffer[i] != 2) {
+      return 2;
+    }
+  }
+  return sentinel ^ 0xEFEF;
+}
+
+int main() {
+  // Generic path, for comparison
+  asm volatile("debugtrap" ::: "memory");
+  libgb::memset(oam_sized.value.data(), 1, oam_sized.value.size());
+  // CHECK: Cycles since last: 478
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::memset(page_sized.value.data(), 2, page_sized.value.size());
+  // CHECK: Cycles since last: 718
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::memcpy(oam_sized_buffer.value.data(), oam_sized.value.data(),
+                oam_sized.value.size());
+  // CHECK: Cycles since last: 1121
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::memcpy(page_sized_buffer.value.data(), page_sized.value.data(),
+                page_sized.value.size());
+  // CHECK: Cycles since last: 1745
+  asm volatile("debugtrap" ::: "memory");
+
+  // Page-local path
+  libgb::memset(oam_sized, 1);
+  // CHECK: Cycles since last: 422
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::memset(page_sized, 2);
+  // CHECK: Cycles since last: 662
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::memcpy(oam_sized_buffer, oam_sized);
+  // CHECK: Cycles since last: 899
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::memcpy(page_sized_buffer, page_sized);
+  // CHECK: Cycles since last: 1427
+  asm volatile("debugtrap" ::: "memory");
+
+  // CHECK: hl=0000
+  return check_result();
+}
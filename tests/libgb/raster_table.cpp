@@ -0,0 +1,74 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/raster_table.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/registers.hpp>
+#include <libgb/dimensions.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/raster.hpp>
+#include <libgb/std/memcpy.hpp>
+
+#include <stdint.h>
+
+static libgb::RasterTable<4> raster;
+
+static auto wait_for_line(uint8_t line) -> void {
+  while (libgb::arch::get_lcd_y_coord() != line) {
+  }
+}
+
+int main() {
+  libgb::enable_interrupts();
+  raster.start();
+
+  raster.clear();
+  raster.add(libgb::Pixels{10}, libgb::arch::background_viewport_x_addr, 1);
+  // Several writes on the same line
+  raster.add(libgb::Pixels{60}, libgb::arch::background_viewport_x_addr, 2);
+  raster.add(libgb::Pixels{60}, libgb::arch::background_viewport_y_addr, 3);
+  raster.present();
+
+  // Waits for the table above to be picked up
+  raster.clear();
+
+  wait_for_line(30);
+  if (libgb::arch::get_background_viewport_x() != 1) {
+    return 1;
+  }
+  wait_for_line(80);
+  if (libgb::arch::get_background_viewport_x() != 2 or
+      libgb::arch::get_background_viewport_y() != 3) {
+    return 2;
+  }
+
+  // The next table replaces this one on the following frame
+  raster.add(libgb::Pixels{10}, libgb::arch::background_viewport_y_addr, 0);
+  raster.add(libgb::Pixels{20}, libgb::arch::background_viewport_x_addr, 4);
+  raster.present();
+  raster.clear();
+
+  wait_for_line(40);
+  if (libgb::arch::get_background_viewport_x() != 4) {
+    return 3;
+  }
+
+  // A shorter table in the buffer of the first one, its leftover entries must
+  // never play
+  raster.add(libgb::Pixels{20}, libgb::arch::background_viewport_x_addr, 5);
+  // Published from a section that already holds interrupts off
+  libgb::disable_interrupts();
+  raster.present<libgb::InterruptState::disabled>();
+  libgb::enable_interrupts();
+  raster.clear();
+
+  for (uint8_t frame = 0; frame < 2; frame += 1) {
+    wait_for_line(80);
+    if (libgb::arch::get_background_viewport_x() != 5 or
+        libgb::arch::get_background_viewport_y() != 0) {
+      return 4;
+    }
+    wait_for_line(100);
+  }
+  raster.stop();
+
+  // CHECK: hl=0000
+  return 0;
+}
@@ -0,0 +1,83 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/scene_transition.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/tile_allocation.hpp>
+#include <libgb/video.hpp>
+
+#include "test_tiles.hpp"
+
+#include <stdint.h>
+
+static constexpr auto shared_tile_1 = filled_tile(0x11);
+static constexpr auto shared_tile_2 = filled_tile(0x22);
+static constexpr auto menu_tile = filled_tile(0x33);
+static constexpr auto game_tile = filled_tile(0x44);
+static constexpr auto sprite_tile = filled_tile(0x55);
+
+static constexpr auto all_scenes = [] {
+  libgb::TileRegistry registry;
+  libgb::Scene menu;
+  menu.register_background_tile(registry, shared_tile_1);
+  menu.register_background_tile(registry, shared_tile_2);
+  menu.register_background_tile(registry, menu_tile);
+  menu.register_sprite_tile(registry, sprite_tile);
+
+  libgb::Scene game;
+  game.register_background_tile(registry, shared_tile_1);
+  game.register_background_tile(registry, shared_tile_2);
+  game.register_background_tile(registry, game_tile);
+  game.register_sprite_tile(registry, sprite_tile);
+  return libgb::SceneManager(registry, menu, game);
+}();
+
+// Only game_tile needs to be uploaded
+static constexpr auto changes = libgb::impl::changed_scene_slots(
+    all_scenes.m_scenes[0], all_scenes.m_scenes[1]);
+static_assert([] {
+  size_t count = 0;
+  for (size_t index = 0; index < libgb::Scene::tiles_per_region; index += 1) {
+    count += changes.m_sprite_tiles[index] !=
+             libgb::TileRegistryIndex::invalid_index;
+    count += changes.m_background_tiles[index] !=
+             libgb::TileRegistryIndex::invalid_index;
+  }
+  return count;
+}() == 1);
+
+// The menu's background tiles are in consecutive slots, they go out with a
+// single stack_blit under ScopedLCDOffGuard
+static_assert([] {
+  constexpr auto runs = libgb::impl::find_scene_tile_runs<
+      all_scenes.m_scenes[0],
+      all_scenes.m_tile_registry.m_all_sprite_tiles.size()>();
+  return runs.size() == 2 and
+         runs[1].tile_count >= libgb::impl::stack_blit_minimum_run;
+}());
+
+template <libgb::arch::Tile const &tile>
+static auto check_background_tile() -> bool {
+  return check_tile(all_scenes.background_tile_address(1, tile), tile);
+}
+
+int main() {
+  libgb::enable_interrupts();
+  libgb::ScopedLCDOffGuard guard;
+  libgb::setup_scene_tile_mapping<all_scenes, 0>(guard);
+  libgb::transition_scene<all_scenes, 0, 1>(guard);
+
+  if (not check_background_tile<shared_tile_1>() or
+      not check_background_tile<shared_tile_2>() or
+      not check_background_tile<game_tile>()) {
+    return 1;
+  }
+  if (not check_tile(all_scenes.sprite_tile_address(1, sprite_tile),
+                     sprite_tile)) {
+    return 2;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
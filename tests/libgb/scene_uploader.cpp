@@ -0,0 +1,88 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/scene_uploader.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/format.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/scene_uploader.hpp>
+#include <libgb/tile_allocation.hpp>
+#include <libgb/video.hpp>
+
+#include "test_tiles.hpp"
+
+#include <stdint.h>
+
+static constexpr uint8_t background_tile_count = 16;
+static constexpr auto sprite_tile = filled_tile(0xaa);
+static constexpr auto shared_tile = filled_tile(0xbb);
+
+static constexpr auto all_scenes = [] {
+  libgb::TileRegistry registry;
+  libgb::Scene menu;
+  menu.register_background_tile(registry, numbered_tile(0));
+
+  libgb::Scene game;
+  for (uint8_t number = 0; number < background_tile_count; number += 1) {
+    game.register_background_tile(registry, numbered_tile(number));
+  }
+  game.register_sprite_tile(registry, sprite_tile);
+  game.register_sprite_tile(registry, shared_tile);
+  game.register_background_tile(registry, shared_tile);
+  return libgb::SceneManager(registry, menu, game);
+}();
+
+static libgb::SceneUploader uploader;
+
+static auto frames_until_uploaded(uint16_t budget) -> int {
+  int frames = 0;
+  while (not uploader.is_done()) {
+    libgb::wait_for_interrupt<libgb::Interrupt::vblank>();
+    uploader.step(budget);
+    frames += 1;
+  }
+  return frames;
+}
+
+static auto check_game_scene() -> bool {
+  libgb::ScopedLCDOffGuard guard;
+  return check_tile(all_scenes.background_tile_address(1, numbered_tile(0)),
+                    numbered_tile(0)) and
+         check_tile(all_scenes.background_tile_address(
+                        1, numbered_tile(background_tile_count - 1)),
+                    numbered_tile(background_tile_count - 1)) and
+         check_tile(all_scenes.sprite_tile_address(1, sprite_tile),
+                    sprite_tile) and
+         check_tile(all_scenes.sprite_tile_address(1, shared_tile),
+                    shared_tile);
+}
+
+int main() {
+  libgb::enable_interrupts();
+
+  // The emulator will throw an error if there is a contested write into VRAM
+  uploader.start<all_scenes, 0>();
+  libgb::println<"{}">(frames_until_uploaded(
+      libgb::SceneUploader::default_budget));
+  // CHECK: $0001
+
+  // 17 more tiles, 6 per frame
+  uploader.start_transition<all_scenes, 0, 1>();
+  libgb::println<"{}">(frames_until_uploaded(
+      libgb::SceneUploader::default_budget));
+  // CHECK: $0003
+  if (not check_game_scene()) {
+    return 1;
+  }
+
+  // One tile per frame
+  uploader.start<all_scenes, 1>();
+  libgb::println<"{}">(frames_until_uploaded(libgb::tile_upload_cost));
+  // CHECK: $0012
+  if (not check_game_scene()) {
+    return 2;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
@@ -0,0 +1,80 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/shadow_tile_map.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/shadow_tile_map.hpp>
+
+#include <stdint.h>
+
+using Shadow = libgb::ShadowTileMap<libgb::Tiles{10}, libgb::Tiles{16}>;
+static Shadow shadow;
+static volatile int result = 0;
+
+static auto flush() -> void {
+  // The emulator will throw an error if there is a contested write into VRAM
+  libgb::wait_for_interrupt<libgb::Interrupt::vblank, [] {
+    shadow.flush<libgb::TileMap::map_0, libgb::RowOrder::bottom_to_top>(
+        libgb::Tiles{2}, libgb::Tiles{1});
+  }>();
+}
+
+// Shadow row 0 is the bottom row, (2, 1) is the top left corner
+static auto vram_cell(uint8_t y, uint8_t x) -> libgb::TileIndex volatile & {
+  return libgb::arch::tile_maps->maps[0].data[2 + 15 - y][1 + x];
+}
+
+int main() {
+  libgb::enable_interrupts();
+
+  // Everything starts out dirty
+  shadow.set(libgb::Tiles{3}, libgb::Tiles{4}, libgb::TileIndex{7});
+  flush();
+  libgb::wait_for_interrupt<libgb::Interrupt::vblank, [] {
+    if (vram_cell(3, 4) != libgb::TileIndex{7}) {
+      result = 1;
+    }
+    // Scribble over a clean row, the next flush must leave it alone
+    vram_cell(5, 0) = libgb::TileIndex{9};
+  }>();
+
+  shadow.fill_row(libgb::Tiles{0}, libgb::TileIndex{2});
+  shadow.move_rows(libgb::Tiles{1}, libgb::Tiles{0}, 2);
+  flush();
+  libgb::wait_for_interrupt<libgb::Interrupt::vblank, [] {
+    if (vram_cell(5, 0) != libgb::TileIndex{9}) {
+      result = 2;
+    }
+    if (vram_cell(2, 9) != libgb::TileIndex{0}) {
+      result = 3;
+    }
+    if (vram_cell(1, 9) != libgb::TileIndex{2}) {
+      result = 4;
+    }
+  }>();
+
+  // Rows that don't fit in the budget are carried over to the next flush
+  for (uint8_t y = 0; y < 16; y += 1) {
+    shadow.set(libgb::Tiles{y}, libgb::Tiles{0}, libgb::TileIndex{5});
+  }
+  libgb::wait_for_interrupt<libgb::Interrupt::vblank, [] {
+    shadow.flush<libgb::TileMap::map_0, libgb::RowOrder::bottom_to_top>(
+        libgb::Tiles{2}, libgb::Tiles{1}, 4 * Shadow::row_upload_cost);
+  }>();
+  libgb::wait_for_interrupt<libgb::Interrupt::vblank, [] {
+    if (vram_cell(3, 0) != libgb::TileIndex{5} or
+        vram_cell(4, 0) == libgb::TileIndex{5}) {
+      result = 5;
+    }
+  }>();
+  flush();
+  libgb::wait_for_interrupt<libgb::Interrupt::vblank, [] {
+    if (vram_cell(15, 0) != libgb::TileIndex{5}) {
+      result = 6;
+    }
+  }>();
+
+  // CHECK: hl=0000
+  return result;
+}
@@ -0,0 +1,90 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/shared_tiles.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/tile_allocation.hpp>
+#include <libgb/std/enum.hpp>
+#include <libgb/video.hpp>
+
+#include "test_tiles.hpp"
+
+#include <stdint.h>
+
+static constexpr auto piece_tile = filled_tile(0x11);
+static constexpr auto completed_piece_tile = filled_tile(0x22);
+static constexpr auto background_tile = filled_tile(0x33);
+// 0x44 would be the x-flip of 0x22 and share its slot
+static constexpr auto sprite_tile = filled_tile(0x66);
+
+static constexpr auto all_scenes = [] {
+  libgb::TileRegistry registry;
+  libgb::Scene scene;
+  // Shared whichever use comes first
+  scene.register_background_tile(registry, piece_tile);
+  scene.register_sprite_tile(registry, piece_tile);
+  scene.register_sprite_tile(registry, completed_piece_tile);
+  scene.register_background_tile(registry, completed_piece_tile);
+
+  scene.register_background_tile(registry, background_tile);
+  scene.register_sprite_tile(registry, sprite_tile);
+  return libgb::SceneManager(registry, scene);
+}();
+
+// Both uses get the same index in 0x8800-0x8fff
+static_assert(libgb::to_underlying(
+                  all_scenes.sprite_tile_index(0, piece_tile)) >= 128);
+static_assert(all_scenes.sprite_tile_index(0, piece_tile) ==
+              all_scenes.background_tile_index(0, piece_tile));
+static_assert(libgb::to_underlying(all_scenes.sprite_tile_index(
+                  0, completed_piece_tile)) >= 128);
+static_assert(all_scenes.sprite_tile_index(0, completed_piece_tile) ==
+              all_scenes.background_tile_index(0, completed_piece_tile));
+static_assert(libgb::to_underlying(
+                  all_scenes.sprite_tile_index(0, sprite_tile)) < 128);
+static_assert(libgb::to_underlying(all_scenes.background_tile_address(
+                  0, background_tile)) >= 0x9000);
+
+// Two tiles less to upload than with separate copies
+static_assert([] {
+  size_t count = 0;
+  auto const &scene = all_scenes.m_scenes[0];
+  for (size_t index = 0; index < libgb::Scene::tiles_per_region; index += 1) {
+    count += scene.m_sprite_tiles[index] !=
+             libgb::TileRegistryIndex::invalid_index;
+    count += scene.m_background_tiles[index] !=
+             libgb::TileRegistryIndex::invalid_index;
+    count += scene.m_shared_tiles[index] !=
+             libgb::TileRegistryIndex::invalid_index;
+  }
+  return count;
+}() == 4);
+
+template <libgb::arch::Tile const &tile> static auto check_tiles() -> bool {
+  return check_tile(all_scenes.sprite_tile_address(0, tile), tile) and
+         check_tile(all_scenes.background_tile_address(0, tile), tile);
+}
+
+template <libgb::TileDataFormat format> static auto check_format() -> bool {
+  libgb::ScopedLCDOffGuard guard;
+  libgb::setup_scene_tile_mapping<all_scenes, 0, format>(guard);
+  return check_tiles<piece_tile>() and check_tiles<completed_piece_tile>() and
+         check_tile(all_scenes.background_tile_address(0, background_tile),
+                    background_tile) and
+         check_tile(all_scenes.sprite_tile_address(0, sprite_tile),
+                    sprite_tile);
+}
+
+int main() {
+  libgb::enable_interrupts();
+  if (not check_format<libgb::TileDataFormat::raw>()) {
+    return 1;
+  }
+  if (not check_format<libgb::TileDataFormat::compressed>()) {
+    return 2;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
@@ -0,0 +1,76 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/sprite_allocator.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/sprite.hpp>
+#include <libgb/arch/sprite_map.hpp>
+#include <libgb/sprite_allocator.hpp>
+
+#include <stdint.h>
+
+// 2x2 tiles, the right half mirrors the left one
+static constexpr libgb::Metasprite<4> ball = {{{
+    libgb::metasprite_part(0, 0, {libgb::TileIndex{1}, false, false}),
+    libgb::metasprite_part(0, 8, {libgb::TileIndex{1}, true, false}),
+    libgb::metasprite_part(8, 0, {libgb::TileIndex{2}, false, false}),
+    libgb::metasprite_part(8, 8, {libgb::TileIndex{2}, true, false}),
+}}};
+
+static constexpr uint8_t fixed_slots = 2;
+static libgb::SpriteAllocator sprites{fixed_slots};
+
+static auto is_ball_at(uint8_t slot, uint8_t y, uint8_t x) -> bool {
+  auto const &top_right = libgb::inactive_sprite_map[slot + 1];
+  auto const &bottom_left = libgb::inactive_sprite_map[slot + 2];
+  return libgb::inactive_sprite_map[slot].pos_y == y and
+         libgb::inactive_sprite_map[slot].pos_x == x and
+         top_right.pos_x == x + 8 and top_right.attributes.flip_x and
+         top_right.index == libgb::TileIndex{1} and
+         bottom_left.pos_y == y + 8 and
+         bottom_left.index == libgb::TileIndex{2} and
+         not bottom_left.attributes.flip_x;
+}
+
+int main() {
+  libgb::inactive_sprite_map[0].pos_y = 42;
+
+  sprites.begin_frame();
+  sprites.draw<ball>(16, 8);
+  sprites.draw<ball>(32, 64);
+  sprites.end_frame();
+  if (not is_ball_at(fixed_slots, 16, 8) or
+      not is_ball_at(fixed_slots + 4, 32, 64)) {
+    return 1;
+  }
+
+  // The second ball is gone, its slots get hidden
+  sprites.begin_frame();
+  sprites.draw<ball>(48, 24);
+  sprites.end_frame();
+  if (not is_ball_at(fixed_slots, 48, 24)) {
+    return 2;
+  }
+  for (uint8_t slot = fixed_slots + 4; slot < fixed_slots + 8; slot += 1) {
+    if (libgb::inactive_sprite_map[slot].pos_y != 0) {
+      return 3;
+    }
+  }
+
+  // Metasprites that don't fit are dropped whole
+  sprites.begin_frame();
+  uint8_t drawn = 0;
+  while (sprites.draw<ball>(16, 8)) {
+    drawn += 1;
+  }
+  sprites.end_frame();
+  if (drawn != (40 - fixed_slots) / 4 or sprites.used_slots() != 4 * drawn) {
+    return 4;
+  }
+  if (not sprites.draw(libgb::arch::Sprite{}) or
+      not sprites.draw(libgb::arch::Sprite{})) {
+    return 5;
+  }
+
+  // The fixed slots are never touched
+  // CHECK: hl=0000
+  return libgb::inactive_sprite_map[0].pos_y != 42;
+}
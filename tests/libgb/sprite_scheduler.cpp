@@ -0,0 +1,102 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/sprite_scheduler.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/sprite.hpp>
+#include <libgb/arch/sprite_map.hpp>
+#include <libgb/sprite_scheduler.hpp>
+#include <libgb/std/enum.hpp>
+
+#include <stdint.h>
+
+static constexpr uint8_t sprite_count = 40;
+static constexpr uint8_t crowded_count = 12;
+
+static libgb::SpriteScheduler<sprite_count> sprites;
+
+static auto first_slot_at(uint8_t pos_y) -> uint8_t {
+  uint8_t slot = 0;
+  while (libgb::inactive_sprite_map[slot].pos_y != pos_y) {
+    slot += 1;
+  }
+  return slot;
+}
+
+// 10 sprites fill a band and one more sits a line lower, in the next band.
+// They share 7 lines, where the hardware only draws the first 10 in OAM.
+static auto straddling_sprite_gets_a_turn() -> bool {
+  static libgb::SpriteScheduler<11> straddling;
+  static libgb::arch::SpriteMap map;
+  for (uint8_t index = 0; index < 10; index += 1) {
+    straddling[index] = {.pos_y = 39,
+                         .pos_x = (uint8_t)(8 + 8 * index),
+                         .index = libgb::TileIndex{0},
+                         .attributes = {}};
+  }
+  straddling[10] = {.pos_y = 40,
+                    .pos_x = 8,
+                    .index = libgb::TileIndex{1},
+                    .attributes = {}};
+
+  bool is_drawn = false;
+  for (uint8_t frame = 0; frame < 2; frame += 1) {
+    straddling.schedule(map);
+    for (uint8_t slot = 0; slot < 10; slot += 1) {
+      is_drawn = is_drawn or map[slot].pos_y == 40;
+    }
+  }
+  return is_drawn;
+}
+
+int main() {
+  // Laid out in reverse so that the first schedule has to sort everything
+  for (uint8_t index = 0; index < sprite_count; index += 1) {
+    auto &sprite = sprites[sprite_count - index - 1];
+    sprite.index = libgb::TileIndex{index};
+    if (index < crowded_count) {
+      // All on the same lines, two too many
+      sprite.pos_y = 40;
+      sprite.pos_x = 8 + 8 * index;
+    } else {
+      sprite.pos_y = 48 + 3 * index;
+      sprite.pos_x = 8 + 4 * index;
+    }
+  }
+
+  if (not straddling_sprite_gets_a_turn()) {
+    return 3;
+  }
+
+  // Every crowded sprite gets a turn at the front of its band
+  uint16_t seen_at_front = 0;
+  for (uint8_t frame = 0; frame < crowded_count; frame += 1) {
+    sprites.schedule();
+    seen_at_front |= 1U << libgb::to_underlying(
+                         libgb::inactive_sprite_map[first_slot_at(40)].index);
+  }
+  if (seen_at_front != (1U << crowded_count) - 1) {
+    return 1;
+  }
+
+  // The common case, everything moved a little
+  for (uint8_t index = 0; index < sprite_count; index += 1) {
+    sprites[index].pos_x += 1;
+    sprites[index].pos_y += index % 2;
+  }
+
+  asm volatile("debugtrap" ::: "memory");
+  sprites.schedule();
+  // CHECK: Cycles since last: {{([0-9]?[0-9]?[0-9]|[1-4][0-9][0-9][0-9])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  // An even number of frames so far, this one went top to bottom. The others
+  // are still sorted by band.
+  for (uint8_t slot = crowded_count + 1; slot < sprite_count; slot += 1) {
+    if (libgb::inactive_sprite_map[slot].pos_y >> 3U <
+        libgb::inactive_sprite_map[slot - 1].pos_y >> 3U) {
+      return 2;
+    }
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
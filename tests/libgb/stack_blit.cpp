@@ -0,0 +1,67 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/stack_blit.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+
+#include <libgb/arch/registers.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/memcpy.hpp>
+
+#include <stdint.h>
+
+libgb::Array<uint8_t, 1024> source;
+
+libgb::Array<uint8_t, 1024> buffer;
+volatile uint16_t sentinel = 0xEFEFU;
+volatile uint8_t vblank_count = 0;
+
+auto check_result() -> int {
+  for (size_t i = 0; i < buffer.size(); i += 1) {
+    if (buffer[i] != (uint8_t)(i * 7U)) {
+      return 1;
+    }
+  }
+  return sentinel ^ 0xEFEF;
+}
+
+int main() {
+  libgb::enable_interrupts();
+  for (size_t i = 0; i < source.size(); i += 1) {
+    source[i] = (uint8_t)(i * 7U);
+  }
+
+  // Bounded by the old byte by byte memcpy, 26 + 10 cycles per byte as measured
+  // for 10 and 40 bytes
+  asm volatile("debugtrap" ::: "memory");
+  libgb::stack_blit(buffer.data(), source.data(), 16);
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|1[0-7][0-9]|18[0-6])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  // Not a multiple of 16, the remainder is copied byte by byte
+  libgb::stack_blit(buffer.data(), source.data(), 20);
+  // CHECK: Cycles since last: {{([0-9]?[0-9]|1[0-9][0-9]|2[0-1][0-9]|22[0-6])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::stack_blit(buffer.data(), source.data(), 256);
+  // CHECK: Cycles since last: {{([0-9]?[0-9]?[0-9]|1[0-9][0-9][0-9]|2[0-4][0-9][0-9]|25[0-7][0-9]|258[0-6])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  libgb::stack_blit(buffer.data(), source.data(), source.size());
+  // CHECK: Cycles since last: {{([0-9]?[0-9]?[0-9]?[0-9]|10[0-1][0-9][0-9]|102[0-5][0-9]|1026[0-6])$}}
+  asm volatile("debugtrap" ::: "memory");
+
+  // Called with interrupts off, e.g. from a handler, they must stay off
+  libgb::disable_interrupts();
+  libgb::enable_vblank_interrupt(
+      [] [[gnu::gb_interrupt_cc]] () { vblank_count += 1; });
+  libgb::arch::set_interrupt_flag_vblank(true);
+  libgb::stack_blit<libgb::InterruptState::disabled>(buffer.data(),
+                                                     source.data(), 32);
+  libgb::disable_vblank_interrupt();
+  libgb::enable_interrupts();
+  if (vblank_count != 0) {
+    return 2;
+  }
+
+  // CHECK: hl=0000
+  return check_result();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// Tiles and VRAM checks shared by the scene tests
+
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/std/enum.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Every byte set to value. Careful with sprites, a value whose bits mirror
+// another's is its x-flip and gets deduplicated.
+constexpr auto filled_tile(uint8_t value) -> libgb::arch::Tile {
+  libgb::arch::Tile tile;
+  for (auto &byte : tile.data) {
+    byte = value;
+  }
+  return tile;
+}
+
+// A distinct background tile for each number
+constexpr auto numbered_tile(size_t number) -> libgb::arch::Tile {
+  libgb::arch::Tile tile = {};
+  tile.data[0] = (uint8_t)number;
+  tile.data[1] = (uint8_t)(number >> 8U);
+  return tile;
+}
+
+// VRAM must be accessible
+inline auto check_tile(libgb::TileAddress address,
+                       libgb::arch::Tile const &tile) -> bool {
+  auto const *vram =
+      (uint8_t const volatile *)libgb::to_underlying(address);
+  for (auto byte : tile.data) {
+    if (*vram++ != byte) {
+      return false;
+    }
+  }
+  return true;
+}
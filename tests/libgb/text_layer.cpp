@@ -0,0 +1,119 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/text_layer.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/text_layer.hpp>
+#include <libgb/tile_allocation.hpp>
+#include <libgb/video.hpp>
+
+#include "test_tiles.hpp"
+
+#include <stdint.h>
+
+template <size_t GlyphCount>
+static constexpr auto make_font(char first_char) -> libgb::Font<GlyphCount> {
+  libgb::Font<GlyphCount> font = {.first_char = first_char, .glyphs = {}};
+  for (size_t index = 0; index < GlyphCount; index += 1) {
+    for (auto &byte : font.glyphs[index].data) {
+      byte = (uint8_t)(first_char + index);
+    }
+  }
+  return font;
+}
+
+static constexpr auto digits = make_font<10>('0');
+static constexpr auto letters = make_font<26>('A');
+static constexpr size_t cached_letter_count = 4;
+
+static constexpr auto all_scenes = [] {
+  libgb::TileRegistry registry;
+  libgb::Scene scene;
+  digits.register_tiles(registry, scene);
+  scene.register_background_tile(registry, libgb::arch::Tile{});
+  scene.reserve_background_tiles(cached_letter_count);
+  return libgb::SceneManager(registry, scene);
+}();
+
+static_assert(all_scenes.reserved_background_tiles(0).size() ==
+              cached_letter_count);
+
+static libgb::TextLayer<libgb::Tiles{5}, libgb::Tiles{1},
+                        libgb::ResidentGlyphs<all_scenes, 0, digits>>
+    score;
+static libgb::TextLayer<libgb::Tiles{4}, libgb::Tiles{2},
+                        libgb::GlyphCache<all_scenes, 0, letters>>
+    name;
+
+// Enough for every glyph in the cache
+static constexpr uint16_t budget = 4 * libgb::tile_upload_cost;
+
+template <size_t GlyphCount>
+static auto check_text(libgb::Font<GlyphCount> const &font, uint8_t y,
+                       char const *text) -> bool {
+  for (uint8_t x = 0; text[x] != '\0'; x += 1) {
+    auto const index = libgb::arch::tile_maps->maps[0].data[y][x];
+    if (not check_tile(libgb::tile_address(
+                           index, libgb::TileAddressingMode::bg_window_signed),
+                       font.glyphs[font.glyph_index(text[x])])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  libgb::enable_interrupts();
+  libgb::ScopedLCDOffGuard guard;
+  libgb::setup_scene_tile_mapping<all_scenes, 0>(guard);
+
+  score.print<"{}">(libgb::Tiles{0}, libgb::Tiles{0}, (uint16_t)1234);
+  score.flush<libgb::TileMap::map_0>(libgb::Tiles{0}, libgb::Tiles{0}, budget);
+  if (not check_text(digits, 0, "1234")) {
+    return 1;
+  }
+
+  // Fills every slot of the cache, one glyph per flush. The cells wait for the
+  // last one.
+  name.print<"AB">(libgb::Tiles{0}, libgb::Tiles{0});
+  name.print<"{}D">(libgb::Tiles{1}, libgb::Tiles{0}, 'C');
+  auto const &map = libgb::arch::tile_maps->maps[0];
+  auto const old_cell = map.data[2][0];
+  for (uint8_t glyph = 0; glyph < cached_letter_count - 1; glyph += 1) {
+    name.flush<libgb::TileMap::map_0>(libgb::Tiles{2}, libgb::Tiles{0},
+                                      libgb::tile_upload_cost);
+  }
+  if (map.data[2][0] != old_cell) {
+    return 2;
+  }
+  name.flush<libgb::TileMap::map_0>(libgb::Tiles{2}, libgb::Tiles{0},
+                                    libgb::tile_upload_cost);
+  if (not check_text(letters, 2, "AB") or not check_text(letters, 3, "CD")) {
+    return 3;
+  }
+
+  // A is no longer shown, its slot gets reused
+  name.set(libgb::Tiles{0}, libgb::Tiles{0}, 'E');
+  name.flush<libgb::TileMap::map_0>(libgb::Tiles{2}, libgb::Tiles{0}, budget);
+  if (not check_text(letters, 2, "EB") or not check_text(letters, 3, "CD")) {
+    return 4;
+  }
+
+  // Another scene's tiles land in the reserved slots
+  static constexpr auto reserved =
+      libgb::to_array<all_scenes.reserved_background_tiles(0)>();
+  for (auto index : reserved) {
+    libgb::set_tile_data(
+        libgb::tile_address(index, libgb::TileAddressingMode::bg_window_signed),
+        libgb::arch::Tile{});
+  }
+  name.invalidate();
+  name.flush<libgb::TileMap::map_0>(libgb::Tiles{2}, libgb::Tiles{0}, budget);
+  if (not check_text(letters, 2, "EB") or not check_text(letters, 3, "CD")) {
+    return 5;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
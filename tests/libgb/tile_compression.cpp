@@ -0,0 +1,82 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/tile_compression.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/std/enum.hpp>
+#include <libgb/std/fixed_vector.hpp>
+#include <libgb/tile_compression.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+static constexpr auto tiles = [] {
+  libgb::Array<libgb::arch::Tile, 6> tiles = {};
+  // Blank
+  for (auto &byte : tiles[0].data) {
+    byte = 0;
+  }
+  // Solid, one plane only
+  for (size_t i = 0; i < 16; i += 1) {
+    tiles[1].data[i] = i % 2 == 0 ? 0xff : 0x00;
+  }
+  // Border
+  for (size_t i = 0; i < 16; i += 1) {
+    tiles[2].data[i] = i < 2 or i >= 14 ? 0xff : 0x81;
+  }
+  // Same as the one above, back references across tiles
+  tiles[3] = tiles[2];
+  // Noise, incompressible
+  for (size_t i = 0; i < 16; i += 1) {
+    tiles[4].data[i] = (uint8_t)(i * 37U + 11U);
+  }
+  tiles[5] = tiles[1];
+  return tiles;
+}();
+
+static constexpr auto first_address = libgb::tile_address(
+    libgb::TileIndex{1}, libgb::TileAddressingMode::object);
+static constexpr auto second_address = libgb::tile_address(
+    libgb::TileIndex{20}, libgb::TileAddressingMode::object);
+
+static constexpr auto stream = [] {
+  libgb::TileCompressor<libgb::compressed_tile_data_capacity(tiles.size(), 2)>
+      compressor;
+  compressor.add_span(first_address, tiles.data(), 4);
+  compressor.add_span(second_address, tiles.data() + 4, 2);
+  compressor.finish();
+  return compressor.m_stream;
+}();
+static constexpr auto compressed = libgb::to_array<stream>();
+static_assert(compressed.size() < sizeof(tiles) / 2);
+
+static auto check_tiles(libgb::TileAddress address, size_t first, size_t count)
+    -> bool {
+  auto const *vram = (uint8_t const volatile *)libgb::to_underlying(address);
+  for (size_t tile = first; tile < first + count; tile += 1) {
+    for (auto byte : tiles[tile].data) {
+      if (*vram++ != byte) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main() {
+  libgb::enable_interrupts();
+  libgb::ScopedLCDOffGuard guard;
+  libgb::decompress_tile_data(guard, compressed.data());
+
+  if (not check_tiles(first_address, 0, 4)) {
+    return 1;
+  }
+  if (not check_tiles(second_address, 4, 2)) {
+    return 2;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
@@ -0,0 +1,85 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/tile_flip_dedup.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/tile_allocation.hpp>
+#include <libgb/tile_builder.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+using namespace libgb::tile_builder;
+
+static constexpr auto arrow_right_tile = build_tile({{
+    {C0, C0, C0, C3, C0, C0, C0, C0},
+    {C0, C0, C0, C3, C3, C0, C0, C0},
+    {C3, C3, C3, C3, C3, C3, C0, C0},
+    {C3, C3, C3, C3, C3, C3, C3, C0},
+    {C3, C3, C3, C3, C3, C3, C0, C0},
+    {C0, C0, C0, C3, C3, C0, C0, C0},
+    {C0, C0, C0, C3, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+}});
+
+static constexpr auto arrow_left_tile =
+    flip_tile(arrow_right_tile, true, false);
+static constexpr auto arrow_flipped_tile =
+    flip_tile(arrow_right_tile, true, true);
+
+static constexpr auto corner_tile = build_tile({{
+    {C1, C1, C1, C1, C0, C0, C0, C0},
+    {C1, C2, C2, C0, C0, C0, C0, C0},
+    {C1, C2, C0, C0, C0, C0, C0, C0},
+    {C1, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+}});
+
+static constexpr auto bottom_corner_tile = flip_tile(corner_tile, false, true);
+
+static constexpr auto all_scenes = [] {
+  libgb::TileRegistry registry;
+  libgb::Scene scene;
+  scene.register_sprite_tile(registry, arrow_right_tile);
+  scene.register_sprite_tile(registry, arrow_left_tile);
+  scene.register_sprite_tile(registry, arrow_flipped_tile);
+  scene.register_sprite_tile(registry, corner_tile);
+  scene.register_sprite_tile(registry, bottom_corner_tile);
+  return libgb::SceneManager(registry, scene);
+}();
+
+// Only the first of each set of mirror images is stored
+static_assert(all_scenes.m_tile_registry.m_all_sprite_tiles.size() == 2);
+
+static constexpr auto arrow_right =
+    all_scenes.sprite_tile(0, arrow_right_tile);
+static constexpr auto arrow_left = all_scenes.sprite_tile(0, arrow_left_tile);
+static constexpr auto arrow_flipped =
+    all_scenes.sprite_tile(0, arrow_flipped_tile);
+static constexpr auto bottom_corner =
+    all_scenes.sprite_tile(0, bottom_corner_tile);
+
+static_assert(not arrow_right.flip_x and not arrow_right.flip_y);
+static_assert(arrow_left.index == arrow_right.index and arrow_left.flip_x and
+              not arrow_left.flip_y);
+static_assert(arrow_flipped.index == arrow_right.index and
+              arrow_flipped.flip_x and arrow_flipped.flip_y);
+static_assert(bottom_corner.index ==
+                  all_scenes.sprite_tile_index(0, corner_tile) and
+              not bottom_corner.flip_x and bottom_corner.flip_y);
+
+int main() {
+  libgb::enable_interrupts();
+  {
+    // Only two tiles to upload
+    libgb::ScopedLCDOffGuard guard;
+    libgb::setup_scene_tile_mapping<all_scenes, 0>(guard);
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
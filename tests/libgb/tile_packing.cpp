@@ -0,0 +1,116 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/tile_packing.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+// RUN: $GB_TOOLCHAIN/llvm-objdump $GBLIB_BUILD_DIR/tile_packing.out -t \
+// RUN:   | FileCheck %s -check-prefix=SYMBOLS
+
+// The lookups fold away, the full capacity FixedVectors never reach ROM
+// SYMBOLS-NOT: packed_tile_data
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/enum.hpp>
+#include <libgb/tile_allocation.hpp>
+#include <libgb/tile_builder.hpp>
+#include <libgb/video.hpp>
+
+#include <stdint.h>
+
+using namespace libgb::tile_builder;
+
+static constexpr auto star_tile = build_tile({{
+    {C0, C3, C0, C0, C0, C0, C0, C0},
+    {C3, C3, C3, C0, C0, C0, C0, C0},
+    {C0, C3, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+    {C0, C0, C0, C0, C0, C0, C0, C0},
+}});
+
+// Two colours, neither of them 0
+static constexpr auto border_tile = build_tile({{
+    {C1, C1, C1, C1, C1, C1, C1, C1},
+    {C1, C2, C2, C2, C2, C2, C2, C1},
+    {C1, C2, C2, C2, C2, C2, C2, C1},
+    {C1, C2, C2, C2, C2, C2, C2, C1},
+    {C1, C2, C2, C2, C2, C2, C2, C1},
+    {C1, C2, C2, C2, C2, C2, C2, C1},
+    {C1, C2, C2, C2, C2, C2, C2, C1},
+    {C1, C1, C1, C1, C1, C1, C1, C1},
+}});
+
+static constexpr auto solid_tile = build_tile({{
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+    {C2, C2, C2, C2, C2, C2, C2, C2},
+}});
+
+// Needs all four colours
+static constexpr auto gradient_tile = build_tile({{
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+    {C0, C0, C1, C1, C2, C2, C3, C3},
+}});
+
+static_assert(is_1bpp(star_tile) and is_1bpp(border_tile) and
+              is_1bpp(solid_tile) and not is_1bpp(gradient_tile));
+static_assert(to_1bpp(border_tile).colors == 1 * 4 + 2);
+
+static constexpr auto all_scenes = [] {
+  libgb::TileRegistry registry;
+  libgb::Scene scene;
+  scene.register_sprite_tile(registry, star_tile);
+  scene.register_sprite_tile(registry, gradient_tile);
+  scene.register_background_tile(registry, border_tile);
+  scene.register_background_tile(registry, solid_tile);
+  return libgb::SceneManager(registry, scene);
+}();
+
+static auto check_tile(libgb::TileAddress address,
+                       libgb::arch::Tile const &tile) -> bool {
+  auto const *vram = (uint8_t const volatile *)libgb::to_underlying(address);
+  for (auto byte : tile.data) {
+    if (*vram++ != byte) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  libgb::enable_interrupts();
+  libgb::ScopedLCDOffGuard guard;
+  libgb::setup_scene_tile_mapping<all_scenes, 0,
+                                  libgb::TileDataFormat::packed>(guard);
+
+  if (not check_tile(all_scenes.sprite_tile_address(0, star_tile),
+                     star_tile)) {
+    return 1;
+  }
+  if (not check_tile(all_scenes.sprite_tile_address(0, gradient_tile),
+                     gradient_tile)) {
+    return 2;
+  }
+  if (not check_tile(all_scenes.background_tile_address(0, border_tile),
+                     border_tile)) {
+    return 3;
+  }
+  if (not check_tile(all_scenes.background_tile_address(0, solid_tile),
+                     solid_tile)) {
+    return 4;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
@@ -0,0 +1,77 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/tile_placement.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/std/array.hpp>
+#include <libgb/tile_allocation.hpp>
+#include <libgb/video.hpp>
+
+#include "test_tiles.hpp"
+
+#include <stdint.h>
+
+static constexpr size_t shared_count = 10;
+static constexpr size_t menu_count = libgb::Scene::tiles_per_region;
+static constexpr size_t game_only_count = 10;
+
+// The menu fills every slot, so the tiles only used by the game get placement
+// hints that collide with the shared ones
+static constexpr auto greedy_scenes = [] {
+  libgb::TileRegistry registry;
+  libgb::Scene menu;
+  for (size_t number = 0; number < menu_count; number += 1) {
+    menu.register_background_tile(registry, numbered_tile(number));
+  }
+
+  libgb::Scene game;
+  for (size_t number = 0; number < game_only_count; number += 1) {
+    game.register_background_tile(registry, numbered_tile(menu_count + number));
+  }
+  for (size_t number = 0; number < shared_count; number += 1) {
+    game.register_background_tile(registry, numbered_tile(number));
+  }
+  return libgb::SceneManager(registry, menu, game);
+}();
+
+static constexpr libgb::Array<libgb::SceneTransition, 2> transitions = {{
+    {.from = 0, .to = 1},
+    {.from = 1, .to = 0},
+}};
+
+static constexpr auto all_scenes =
+    greedy_scenes.optimise_placement(transitions);
+
+static constexpr auto greedy_costs =
+    greedy_scenes.transition_upload_sizes(transitions);
+static constexpr auto costs = all_scenes.transition_upload_sizes(transitions);
+
+// The shared tiles get moved out of the way by the greedy placement
+static_assert(greedy_costs[0] == 20 * sizeof(libgb::arch::Tile));
+static_assert(greedy_costs[1] == menu_count * sizeof(libgb::arch::Tile));
+// But keep their slot once optimised
+static_assert(costs[0] == game_only_count * sizeof(libgb::arch::Tile));
+static_assert(costs[1] ==
+              (menu_count - shared_count) * sizeof(libgb::arch::Tile));
+
+int main() {
+  libgb::enable_interrupts();
+  libgb::ScopedLCDOffGuard guard;
+  libgb::setup_scene_tile_mapping<all_scenes, 0>(guard);
+  libgb::transition_scene<all_scenes, 0, 1>(guard);
+
+  static constexpr auto shared_tile = numbered_tile(0);
+  static constexpr auto game_tile = numbered_tile(menu_count);
+  if (not check_tile(all_scenes.background_tile_address(1, shared_tile),
+                     shared_tile)) {
+    return 1;
+  }
+  if (not check_tile(all_scenes.background_tile_address(1, game_tile),
+                     game_tile)) {
+    return 2;
+  }
+
+  // CHECK: hl=0000
+  return 0;
+}
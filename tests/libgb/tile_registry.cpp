@@ -0,0 +1,77 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out \
+// RUN:   $GBLIB_BUILD_DIR/tile_registry.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+// Also a compile time benchmark, see `make benchmark_tile_registry`
+#include <libgb/arch/tile.hpp>
+#include <libgb/std/enum.hpp>
+#include <libgb/tile_allocation.hpp>
+
+#include "test_tiles.hpp"
+
+#include <stdint.h>
+
+static constexpr size_t scene_count = 4;
+static constexpr size_t tiles_per_scene = libgb::Scene::tiles_per_region;
+static_assert(scene_count * tiles_per_scene ==
+              libgb::TileRegistry::maximum_tile_count);
+
+static consteval auto make_scene(libgb::TileRegistry &registry, size_t first)
+    -> libgb::Scene {
+  libgb::Scene scene;
+  for (size_t number = first; number < first + tiles_per_scene; number += 1) {
+    scene.register_background_tile(registry, numbered_tile(number));
+  }
+  return scene;
+}
+
+static constexpr auto all_scenes = [] {
+  libgb::TileRegistry registry;
+  auto const scene_0 = make_scene(registry, 0 * tiles_per_scene);
+  auto const scene_1 = make_scene(registry, 1 * tiles_per_scene);
+  auto const scene_2 = make_scene(registry, 2 * tiles_per_scene);
+  auto const scene_3 = make_scene(registry, 3 * tiles_per_scene);
+  return libgb::SceneManager(registry, scene_0, scene_1, scene_2, scene_3);
+}();
+
+static_assert(all_scenes.m_tile_registry.m_all_background_tiles.size() ==
+              libgb::TileRegistry::maximum_tile_count);
+
+// Registering again finds the existing tiles
+static_assert([] {
+  auto registry = all_scenes.m_tile_registry;
+  for (size_t number = 0; number < registry.maximum_tile_count; number += 1) {
+    if (libgb::to_underlying(registry.register_background_tile(
+            numbered_tile(number))) != number) {
+      return false;
+    }
+  }
+  return registry.m_all_background_tiles.size() == registry.maximum_tile_count;
+}());
+
+// Every tile is looked up in every scene it's in
+static_assert([] {
+  for (size_t scene = 0; scene < scene_count; scene += 1) {
+    for (size_t index = 0; index < tiles_per_scene; index += 1) {
+      auto const number = scene * tiles_per_scene + index;
+      if (libgb::to_underlying(all_scenes.background_tile_index(
+              scene, numbered_tile(number))) != index) {
+        return false;
+      }
+    }
+  }
+  return true;
+}());
+
+// Tiles of the other scenes aren't in this one
+static_assert(not all_scenes.m_scenes[0].contains(
+    all_scenes.m_scenes[0].m_background_slots,
+    all_scenes.m_scenes[1].m_background_tiles[0]));
+
+static_assert(all_scenes.m_tile_registry.find_background_tile(
+                  numbered_tile(libgb::TileRegistry::maximum_tile_count)) ==
+              libgb::TileRegistryIndex::invalid_index);
+
+int main() {
+  // CHECK: hl=0000
+  return 0;
+}
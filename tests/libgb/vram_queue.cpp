@@ -0,0 +1,56 @@
+// RUN: $GAMEBOY_EMULATOR_PATH/emulate.out $GBLIB_BUILD_DIR/vram_queue.out \
+// RUN:   | FileCheck %s -check-prefix=CHECK
+#include <libgb/arch/registers.hpp>
+#include <libgb/arch/tile.hpp>
+#include <libgb/arch/tile_data.hpp>
+#include <libgb/arch/tile_map.hpp>
+#include <libgb/format.hpp>
+#include <libgb/interrupts.hpp>
+#include <libgb/vram_queue.hpp>
+
+#include <stdint.h>
+
+static constexpr auto white_tile = [] {
+  libgb::arch::Tile tile;
+  for (auto &byte : tile.data) {
+    byte = 0xff;
+  }
+  return tile;
+}();
+
+static libgb::VramQueue<64> vram_queue;
+
+static auto frames_until_drained() -> int {
+  int frames = 0;
+  while (not vram_queue.empty()) {
+    libgb::wait_for_interrupt<libgb::Interrupt::vblank,
+                              [] { vram_queue.drain(); }>();
+    frames += 1;
+  }
+  return frames;
+}
+
+int main() {
+  libgb::enable_interrupts();
+
+  // The emulator will throw an error if there is a contested write into VRAM
+  for (uint8_t index = 0; index < 32; index += 1) {
+    vram_queue.enqueue_tile_data(
+        libgb::tile_address(libgb::TileIndex{index},
+                            libgb::TileAddressingMode::object),
+        white_tile);
+  }
+  libgb::println<"{}">(frames_until_drained());
+  // CHECK: $0006
+
+  // Only one write fits in the budget, the other carries over
+  vram_queue.set_budget(40);
+  vram_queue.enqueue_tile_mapping<libgb::TileMap::map_0>(
+      libgb::Tiles{1}, libgb::Tiles{2}, libgb::TileIndex{3});
+  vram_queue.enqueue_register(libgb::arch::window_position_y_addr, 42);
+  libgb::println<"{}">(frames_until_drained());
+  // CHECK: $0002
+
+  // CHECK: hl=0000
+  return libgb::arch::get_window_position_y() != 42;
+}
@@ -7,6 +7,7 @@
 #include <libgb/dimensions.hpp>
 #include <libgb/std/array.hpp>
 #include <libgb/std/fixed_vector.hpp>
+#include <libgb/sprite_scheduler.hpp>
 #include <libgb/std/random.hpp>
 #include <libgb/tile_allocation.hpp>
 #include <libgb/tile_builder.hpp>
@@ -142,6 +143,11 @@ static auto valid_star_tile_positions = libgb::to_array<[]() consteval {
   return result;
 }()>();
 
+// Slots 0-7 are the falling piece and its hard drop preview. Crowded lines
+// flicker between stars instead of always dropping the same ones.
+static constexpr uint8_t first_star_slot = 8;
+static libgb::SpriteScheduler<star_count> star_sprites{first_star_slot};
+
 static libgb::Array<uint8_t, star_count> star_show_order;
 static uint8_t additional_stars_to_show = 0;
 static bool is_hiding_all_stars = false;
@@ -160,7 +166,7 @@ template <auto scene_manager> static auto init_stars() -> void {
     auto x_pos = libgb::uniform_in_range<0, 12>();
     auto origin = valid_star_tile_positions[sprite_index];
 
-    libgb::inactive_sprite_map[8 + sprite_index] = {
+    star_sprites[sprite_index] = {
         .pos_y = static_cast<uint8_t>(libgb::count_px(origin.second) + y_pos),
         .pos_x = static_cast<uint8_t>(libgb::count_px(origin.first) + x_pos),
         .index = scene_manager.sprite_tile_index(0, black_tile),
@@ -211,7 +217,7 @@ template <auto scene_manager> static auto animate_show_next_star() -> void {
 
     return scene_manager.sprite_tile_index(0, very_little_star_tile_1);
   }(sprite_index);
-  libgb::inactive_sprite_map[8 + sprite_index].index = tile;
+  star_sprites[sprite_index].index = tile;
 }
 
 struct [[gnu::aligned(2)]] StarAnimation {
@@ -234,7 +240,7 @@ static auto animate_stars(uint8_t frame_count) -> bool {
         auto is_last_star = (star_hide_index + 1 == star_show_index);
         if (not is_last_star || delay_frames_for_last_star == 0) {
           auto sprite_index = star_show_order[star_hide_index++];
-          libgb::inactive_sprite_map[8 + sprite_index].index =
+          star_sprites[sprite_index].index =
               scene_manager.sprite_tile_index(0, black_tile);
         } else {
           delay_frames_for_last_star -= 1;
@@ -253,7 +259,7 @@ static auto animate_stars(uint8_t frame_count) -> bool {
   while (not star_animation_worklist.empty()) {
     auto const &next = star_animation_worklist.front();
     if (frame_count == next.frame_to_finish) {
-      libgb::inactive_sprite_map[next.sprite_index].index = next.target_tile;
+      star_sprites[next.sprite_index].index = next.target_tile;
       star_animation_worklist.pop_front();
     } else {
       break;
@@ -262,8 +268,8 @@ static auto animate_stars(uint8_t frame_count) -> bool {
 
   if (frame_count % 4 == 0) {
     uint8_t star_to_twinkle_index =
-        8 + libgb::uniform_in_range<0, star_count - 1>();
-    auto &star_to_twinkle = libgb::inactive_sprite_map[star_to_twinkle_index];
+        libgb::uniform_in_range<0, star_count - 1>();
+    auto &star_to_twinkle = star_sprites[star_to_twinkle_index];
 
     static constexpr auto very_little_frame_1 =
         scene_manager.sprite_tile_index(0, very_little_star_tile_1);
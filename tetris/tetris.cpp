@@ -9,6 +9,7 @@
 #include <libgb/gameloop.hpp>
 #include <libgb/input.hpp>
 #include <libgb/interrupts.hpp>
+#include <libgb/shadow_tile_map.hpp>
 #include <libgb/state_machine.hpp>
 #include <libgb/std/array.hpp>
 #include <libgb/std/assert.hpp>
@@ -200,9 +201,10 @@ auto setup_lcd_controller() -> void {
   });
 }
 
-[[gnu::noinline]] auto setup_scene(libgb::ScopedVRAMGuard const &guard)
+[[gnu::noinline]] auto setup_scene(libgb::is_vram_guard auto const &guard)
     -> void {
-  libgb::setup_scene_tile_mapping<scene_manager, 0>(guard);
+  libgb::setup_scene_tile_mapping<scene_manager, 0,
+                                  libgb::TileDataFormat::compressed>(guard);
   libgb::fill_tile_mapping<libgb::TileMap::map_0>(
       scene_manager.background_tile_index(0, black_tile));
 
@@ -371,12 +373,7 @@ static auto play_line_clear_sound(uint8_t lines_cleared) -> void {
 }
 
 struct CurrentGrid {
-  static_assert(board_stride > board_width);
-  using Row = libgb::Array<libgb::TileIndex,
-                           libgb::count_as<libgb::Tiles>(board_stride)>;
-  using GridData =
-      libgb::Array<Row, libgb::count_as<libgb::Tiles>(board_height)>;
-  GridData m_data;
+  libgb::ShadowTileMap<board_width, board_height> m_data;
   libgb::Array<uint8_t, libgb::count_as<libgb::Tiles>(board_height)>
       m_tile_count;
 
@@ -397,14 +394,12 @@ struct CurrentGrid {
   }
 
   constexpr auto is_empty(libgb::Tiles y, libgb::Tiles x) const -> bool {
-    return m_data[libgb::count_as<libgb::Tiles>(y)]
-                 [libgb::count_as<libgb::Tiles>(x)] ==
+    return m_data.get(y, x) ==
            scene_manager.background_tile_index(0, black_tile);
   }
 
   constexpr auto set_full(libgb::Tiles y, libgb::Tiles x) -> void {
-    m_data[libgb::count_as<libgb::Tiles>(y)][libgb::count_as<libgb::Tiles>(x)] =
-        scene_manager.background_tile_index(0, piece_tile);
+    m_data.set(y, x, scene_manager.background_tile_index(0, piece_tile));
     m_tile_count[libgb::count_as<libgb::Tiles>(y)] += 1;
   }
 
@@ -424,20 +419,14 @@ struct CurrentGrid {
   }
 
   constexpr auto fill_row(uint8_t row) -> void {
-    libgb::memset(
-        (uint8_t *)&m_data[row],
-        libgb::to_underlying(
-            scene_manager.background_tile_index(0, completed_piece_tile)),
-        sizeof(libgb::TileIndex) * libgb::count_as<libgb::Tiles>(board_width));
+    m_data.fill_row(libgb::Tiles{row}, scene_manager.background_tile_index(
+                                           0, completed_piece_tile));
     m_tile_count[row] = libgb::count_as<libgb::Tiles>(board_width);
   }
 
   constexpr auto clear_row(uint8_t row) -> void {
-    libgb::memset((uint8_t *)&m_data[row],
-                  libgb::to_underlying(
-                      scene_manager.background_tile_index(0, black_tile)),
-                  sizeof(libgb::TileIndex) *
-                      libgb::count_as<libgb::Tiles>(board_width));
+    m_data.fill_row(libgb::Tiles{row},
+                    scene_manager.background_tile_index(0, black_tile));
     m_tile_count[row] = 0;
   }
 
@@ -446,11 +435,9 @@ struct CurrentGrid {
     for (auto [y, tile_count] : libgb::enumerate(m_tile_count)) {
       if (tile_count == libgb::count_as<libgb::Tiles>(board_width)) {
         completed_rows += 1;
-        libgb::memset((uint8_t *)&m_data[y],
-                      libgb::to_underlying(scene_manager.background_tile_index(
-                          0, completed_piece_tile)),
-                      sizeof(libgb::TileIndex) *
-                          libgb::count_as<libgb::Tiles>(board_width));
+        m_data.fill_row(
+            libgb::Tiles{static_cast<uint8_t>(y)},
+            scene_manager.background_tile_index(0, completed_piece_tile));
       }
     }
     return completed_rows;
@@ -465,22 +452,28 @@ struct CurrentGrid {
         continue;
       }
 
-      libgb::memcpy((uint8_t *)&m_data[new_index],
-                    (uint8_t *)&m_data[old_index],
-                    sizeof(libgb::TileIndex) *
-                        libgb::count_as<libgb::Tiles>(board_width));
-      m_tile_count[new_index] = m_tile_count[old_index];
-      old_index += 1;
-      new_index += 1;
+      // Shift the whole run of surviving rows down in one go
+      uint8_t run_end = old_index + 1;
+      while (libgb::Tiles{run_end} != board_height and
+             libgb::Tiles{m_tile_count[run_end]} != board_width) {
+        run_end += 1;
+      }
+      uint8_t const run_length = run_end - old_index;
+
+      if (new_index != old_index) {
+        m_data.move_rows(libgb::Tiles{new_index}, libgb::Tiles{old_index},
+                         run_length);
+        libgb::memmove(&m_tile_count[new_index], &m_tile_count[old_index],
+                       run_length);
+      }
+      old_index = run_end;
+      new_index += run_length;
     }
 
     // Fill out the remaining empty rows
     while (libgb::Tiles{new_index} != board_height) {
-      libgb::memset((uint8_t *)&m_data[new_index],
-                    libgb::to_underlying(
-                        scene_manager.background_tile_index(0, black_tile)),
-                    sizeof(libgb::TileIndex) *
-                        libgb::count_as<libgb::Tiles>(board_width));
+      m_data.fill_row(libgb::Tiles{new_index},
+                      scene_manager.background_tile_index(0, black_tile));
       m_tile_count[new_index] = 0;
       new_index += 1;
     }
@@ -489,30 +482,6 @@ struct CurrentGrid {
 
 constinit static CurrentGrid current_grid = {};
 
-// Defined directly in ASM... The compiler should eventually be good enough to
-// generate this tho.
-extern "C" void copy_grid_into_vram_map_0(CurrentGrid::GridData *grid);
-
-template <size_t parity> inline auto copy_grid_into_vram() -> void {
-#pragma clang loop unroll(full)
-  for (uint8_t row = 0; row < libgb::count_as<libgb::Tiles>(board_height);
-       row += 1) {
-    if (row % 2 != parity) {
-      continue;
-    }
-
-    auto const tile_y = libgb::Tiles{static_cast<uint8_t>(
-        libgb::count_as<libgb::Tiles>(board_height) - row - 1)};
-#pragma clang loop unroll(full)
-    for (uint8_t column = 0;
-         column < libgb::count_as<libgb::Tiles>(board_width); column += 1) {
-      auto const tile_x = libgb::Tiles{column};
-      libgb::set_tile_mapping<libgb::TileMap::map_0>(
-          tile_y, tile_x, current_grid.m_data[row][column]);
-    }
-  }
-}
-
 // Game specific logic
 struct FallingPiece {
   static constexpr libgb::Array underlying_piece_sprites = {
@@ -1040,10 +1009,17 @@ void on_tick() {
   scroll_x += scroll_speed_x;
 
   animate_stars<scene_manager>(libgb::gameloop::tick_count());
+  star_sprites.schedule();
 }
 
 void on_vblank() {
-  copy_grid_into_vram_map_0(&current_grid.m_data);
+  // Leaves room for the scroll registers and the sprite DMA below, a line
+  // clear can dirty the whole board
+  static constexpr uint16_t grid_flush_budget = 850;
+  // Row 0 is the bottom of the board
+  current_grid.m_data
+      .flush<libgb::TileMap::map_0, libgb::RowOrder::bottom_to_top>(
+          libgb::Tiles{0}, libgb::Tiles{0}, grid_flush_budget);
 
   libgb::arch::set_background_viewport_x(-count_px(scroll_x));
   libgb::arch::set_background_viewport_y(libgb::count_px(scroll_y));
@@ -1057,7 +1033,7 @@ int main() {
   setup_lcd_controller();
   libgb::clear_sprite_map(libgb::inactive_sprite_map);
   libgb::copy_into_active_sprite_map(libgb::inactive_sprite_map);
-  setup_scene(libgb::ScopedVRAMGuard{});
+  setup_scene(libgb::ScopedLCDOffGuard{});
   setup_audio();
   play_line_clear_sound(4);
 